@@ -0,0 +1,71 @@
+//
+//  convert.m
+//  MMCalendarEventConvert
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Converts a CSV of events to an MMCalendarEventFile, maps it back and checks that the three queries agree on every day.
+//
+
+#import <Foundation/Foundation.h>
+#import <time.h>
+#import "MMCalendarEventFile.h"
+
+static inline uint64_t MMConvertNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool {
+        if (argc != 3) {
+            fprintf(stderr, "usage: %s events.csv events.mmce\n", argv[0]);
+            return 2;
+        }
+        NSString *csvPath = [NSString stringWithUTF8String:argv[1]];
+        NSString *path = [NSString stringWithUTF8String:argv[2]];
+        NSError *error = nil;
+        if (![MMCalendarEventFile convertCSVAtPath:csvPath toPath:path error:&error]) {
+            fprintf(stderr, "%s\n", error.localizedDescription.UTF8String);
+            return 1;
+        }
+        uint64_t start = MMConvertNanoseconds();
+        MMCalendarEventFile *file = [[MMCalendarEventFile alloc] initWithPath:path error:&error];
+        uint64_t loaded = MMConvertNanoseconds() - start;
+        if (!file) {
+            fprintf(stderr, "%s\n", error.localizedDescription.UTF8String);
+            return 1;
+        }
+        printf("%lu events, days %ld to %ld, longest %lu days, mapped in %.1f us\n", (unsigned long)file.numberOfEvents, (long)file.minimumDayNumber, (long)file.maximumDayNumber, (unsigned long)file.maximumLength, loaded/1000.0);
+        if (!file.numberOfEvents) return 0;
+
+        // A page at a time like the calendar, each day checked against the single-day count and the number of colors listed
+        NSInteger pageSize = 42;
+        NSInteger numbers[42];
+        uint32_t *colorIndexes = malloc(sizeof(uint32_t)*file.numberOfEvents);
+        NSUInteger mismatches = 0, days = 0;
+        start = MMConvertNanoseconds();
+        for (MMCalendarDayNumber firstDayNumber = file.minimumDayNumber - 1; firstDayNumber <= file.maximumDayNumber + 1; firstDayNumber += pageSize) {
+            [file getNumberOfEvents:numbers fromDayNumber:firstDayNumber count:pageSize];
+            for (NSInteger i = 0; i < pageSize; i++) {
+                MMCalendarDayNumber dayNumber = firstDayNumber + i;
+                NSInteger number = [file numberOfEventsForDayNumber:dayNumber];
+                NSUInteger numberOfColors = [file getColorIndexes:colorIndexes maximumCount:file.numberOfEvents forDayNumber:dayNumber];
+                if (number != numbers[i] || (NSUInteger)number != numberOfColors) {
+                    if (mismatches++ < 10) {
+                        fprintf(stderr, "day %ld: %ld events, %ld in page, %lu colors\n", (long)dayNumber, (long)number, (long)numbers[i], (unsigned long)numberOfColors);
+                    }
+                }
+                days++;
+            }
+        }
+        uint64_t elapsed = MMConvertNanoseconds() - start;
+        free(colorIndexes);
+        printf("%lu days checked, %lu mismatches, %.1f ns/day\n", (unsigned long)days, (unsigned long)mismatches, (double)elapsed/days);
+        return mismatches ? 1 : 0;
+    }
+}
@@ -0,0 +1,323 @@
+//
+//  main.m
+//  MMCalendarBenchmark
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Measures the UIKit-free core of MMCalendar (MMCalendarDateEngine, MMCalendarSectionTable and MMCalendarSelection) and prints ns/op and allocations/op.
+//  Every operation mirrors a calculator or layout entry point with the NSIndexPath and UIKit parts left out.
+//  Given a thresholds file, exits with 1 if any operation goes over its budget.
+//
+
+#import <Foundation/Foundation.h>
+#import <time.h>
+#import "MMCalendarDateEngine.h"
+#import "MMCalendarSectionTable.h"
+#import "MMCalendarSelection.h"
+
+#pragma mark - Allocation counting
+
+static size_t MMBenchmarkAllocationCount = 0;
+
+#if defined(__GLIBC__)
+// Route the allocator through glibc's own entry points and count the calls
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+
+void *malloc(size_t size)
+{
+    __atomic_fetch_add(&MMBenchmarkAllocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    __atomic_fetch_add(&MMBenchmarkAllocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    __atomic_fetch_add(&MMBenchmarkAllocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(pointer, size);
+}
+#define MMBenchmarkCountsAllocations 1
+#else
+#define MMBenchmarkCountsAllocations 0
+#endif
+
+static inline size_t MMBenchmarkAllocations(void)
+{
+    return __atomic_load_n(&MMBenchmarkAllocationCount, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t MMBenchmarkNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+// xorshift, the same sequence on every run
+static inline uint32_t MMBenchmarkRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+#pragma mark - Configurations
+
+typedef struct MMBenchmarkRange {
+    const char *name;
+    NSInteger fromYear, fromMonth, fromDay;
+    NSInteger toYear, toMonth, toDay;
+} MMBenchmarkRange;
+
+typedef struct MMBenchmarkPlaceholder {
+    const char *name;
+    MMCalendarSectionOptions options;
+} MMBenchmarkPlaceholder;
+
+static const MMBenchmarkRange MMBenchmarkRanges[] = {
+    {"1y",        2026, 1, 1,  2026, 12, 31},
+    {"1970-2099", 1970, 1, 1,  2099, 12, 31},
+    {"1900-2200", 1900, 1, 1,  2200, 12, 31}
+};
+
+// FillHeadTail and None share the same sections, FillSixRows differs between paging and floating mode
+static const MMBenchmarkPlaceholder MMBenchmarkPlaceholders[] = {
+    {"headTail",        0},
+    {"sixRows",         MMCalendarSectionOptionSixRows|MMCalendarSectionOptionLeadingRow},
+    {"sixRowsFloating", MMCalendarSectionOptionSixRows}
+};
+
+static const char *MMBenchmarkScopeNames[] = {"month", "week"};
+
+#define MMBenchmarkCount(array) (sizeof(array)/sizeof(array[0]))
+
+#pragma mark - Thresholds
+
+// Operation name to @[max ns/op, max allocs/op], the allocation budget is optional
+static NSDictionary<NSString *, NSArray<NSNumber *> *> *MMBenchmarkThresholds = nil;
+static NSUInteger MMBenchmarkNumberOfFailures = 0;
+
+static BOOL MMBenchmarkLoadThresholds(const char *path)
+{
+    NSString *contents = [NSString stringWithContentsOfFile:@(path) encoding:NSUTF8StringEncoding error:NULL];
+    if (!contents) return NO;
+    NSMutableDictionary<NSString *, NSArray<NSNumber *> *> *thresholds = [NSMutableDictionary dictionary];
+    for (NSString *line in [contents componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]]) {
+        if ([line hasPrefix:@"#"]) continue;
+        NSMutableArray<NSString *> *fields = [[line componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] mutableCopy];
+        [fields removeObject:@""];
+        if (fields.count < 2) continue;
+        NSMutableArray<NSNumber *> *limits = [NSMutableArray arrayWithObject:@(fields[1].doubleValue)];
+        if (fields.count > 2) [limits addObject:@(fields[2].doubleValue)];
+        thresholds[fields[0]] = limits;
+    }
+    MMBenchmarkThresholds = thresholds.copy;
+    return YES;
+}
+
+static const char *MMBenchmarkCheck(const char *label, double nanoseconds, double allocations)
+{
+    NSArray<NSNumber *> *limits = MMBenchmarkThresholds[@(label)];
+    if (!limits) return "";
+    BOOL failed = nanoseconds > limits[0].doubleValue;
+    failed |= MMBenchmarkCountsAllocations && limits.count > 1 && allocations > limits[1].doubleValue;
+    if (!failed) return "";
+    MMBenchmarkNumberOfFailures++;
+    return " OVER BUDGET";
+}
+
+#pragma mark - Measurement
+
+static NSUInteger MMBenchmarkIterations = 200000;
+static volatile NSInteger MMBenchmarkSink;
+
+// Prints a row after the columns the caller formatted into `columns`
+#define MMBenchmarkMeasure(label, ...) \
+    do { \
+        size_t allocations = MMBenchmarkAllocations(); \
+        uint64_t start = MMBenchmarkNanoseconds(); \
+        @autoreleasepool { \
+            for (NSUInteger i = 0; i < MMBenchmarkIterations; i++) { \
+                __VA_ARGS__ \
+            } \
+        } \
+        uint64_t elapsed = MMBenchmarkNanoseconds() - start; \
+        allocations = MMBenchmarkAllocations() - allocations; \
+        double nanoseconds = (double)elapsed/MMBenchmarkIterations; \
+        double allocationsPerIteration = (double)allocations/MMBenchmarkIterations; \
+        printf("%s %-20s %10.1f %10.2f%s\n", columns, label, nanoseconds, allocationsPerIteration, MMBenchmarkCheck(label, nanoseconds, allocationsPerIteration)); \
+    } while (0)
+
+static void MMBenchmarkRun(NSString *identifier, MMBenchmarkRange range, MMCalendarScope scope, MMBenchmarkPlaceholder placeholder)
+{
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"UTC"];
+    NSCalendar *gregorian = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    gregorian.timeZone = timeZone;
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:identifier];
+    if (!calendar) {
+        printf("%-20s unavailable\n", identifier.UTF8String);
+        return;
+    }
+    calendar.timeZone = timeZone;
+    char columns[64];
+    snprintf(columns, sizeof(columns), "%-20s %-10s %-6s %-16s", identifier.UTF8String, range.name, MMBenchmarkScopeNames[scope], placeholder.name);
+
+    NSDateComponents *components = [[NSDateComponents alloc] init];
+    components.year = range.fromYear; components.month = range.fromMonth; components.day = range.fromDay;
+    NSDate *minimumDate = [gregorian dateFromComponents:components];
+    components.year = range.toYear; components.month = range.toMonth; components.day = range.toDay;
+    NSDate *maximumDate = [gregorian dateFromComponents:components];
+
+    MMCalendarDateEngine *engine = [[MMCalendarDateEngine alloc] initWithCalendar:calendar minimumDate:minimumDate];
+    MMCalendarDayNumber minimumDayNumber = [engine dayNumberForDate:minimumDate];
+    MMCalendarDayNumber maximumDayNumber = [engine dayNumberForDate:maximumDate];
+    MMCalendarSectionTable *table = [[MMCalendarSectionTable alloc] initWithEngine:engine minimumDayNumber:minimumDayNumber maximumDayNumber:maximumDayNumber];
+    MMCalendarSectionOptions options = placeholder.options;
+    NSInteger numberOfSections = scope == MMCalendarScopeMonth ? table.numberOfMonths : table.numberOfWeeks;
+    NSInteger numberOfItems = scope == MMCalendarScopeMonth ? MMCalendarMaximumNumberOfDaysInPage : 7;
+
+    // Inputs are prepared up front so that only the operation itself is measured
+    NSUInteger numberOfInputs = 4096;
+    uint32_t state = 2463534242u;
+    NSMutableArray<NSDate *> *dates = [NSMutableArray arrayWithCapacity:numberOfInputs];
+    NSInteger *sections = malloc(sizeof(NSInteger)*numberOfInputs);
+    for (NSUInteger i = 0; i < numberOfInputs; i++) {
+        MMCalendarDayNumber dayNumber = minimumDayNumber + MMBenchmarkRandom(&state) % (maximumDayNumber - minimumDayNumber + 1);
+        [dates addObject:[engine dateForDayNumber:dayNumber]];
+        sections[i] = MMBenchmarkRandom(&state) % numberOfSections;
+    }
+    NSUInteger mask = numberOfInputs - 1;
+
+    // Scrolling walks the sections in order, picking and jumping to dates hits them at random
+    MMBenchmarkMeasure("dateForIndexPath", {
+        NSInteger section = (i / numberOfItems) % numberOfSections;
+        MMCalendarDayNumber dayNumber = [table dayNumberForItem:i % numberOfItems section:section scope:scope options:options];
+        MMBenchmarkSink = (NSInteger)(__bridge void *)[engine dateForDayNumber:dayNumber];
+    });
+
+    MMBenchmarkMeasure("indexPathForDate", {
+        NSInteger item = 0, section = 0;
+        [table getItem:&item section:&section forDayNumber:[engine dayNumberForDate:dates[i & mask]] atMonthPosition:MMCalendarMonthPositionCurrent scope:scope options:options];
+        MMBenchmarkSink = item + section;
+    });
+
+    MMBenchmarkMeasure("monthPosition", {
+        NSInteger section = (i / numberOfItems) % numberOfSections;
+        MMBenchmarkSink = [table monthPositionForItem:i % numberOfItems section:section scope:scope options:options];
+    });
+
+    MMBenchmarkMeasure("numberOfRowsInMonth", {
+        MMBenchmarkSink = [table numberOfRowsInMonthOfDayNumber:[engine dayNumberForDate:dates[i & mask]] options:options];
+    });
+
+    MMBenchmarkMeasure("dayInfosForPage", {
+        MMCalendarDayInfo dayInfos[MMCalendarMaximumNumberOfDaysInPage];
+        MMBenchmarkSink = [table getDayInfos:dayInfos forSection:i % numberOfSections scope:scope options:options today:minimumDayNumber weekendMask:(1<<1)|(1<<7)];
+    });
+
+    // The floating layout asks the table for section tops, with 40pt headers and 50pt rows
+    double headerHeight = 40, rowHeight = 50;
+    MMBenchmarkMeasure("frameForSection", {
+        MMBenchmarkSink = [table topForSection:sections[i & mask] headerHeight:headerHeight rowHeight:rowHeight scope:scope options:options];
+    });
+
+    NSInteger contentHeight = [table topForSection:numberOfSections headerHeight:headerHeight rowHeight:rowHeight scope:scope options:options];
+    MMBenchmarkMeasure("sectionForOffset", {
+        double offset = MMBenchmarkRandom(&state) % contentHeight;
+        MMBenchmarkSink = [table sectionAtOffset:offset fromSection:0 numberOfSections:numberOfSections inclusive:YES headerHeight:headerHeight rowHeight:rowHeight scope:scope options:options];
+    });
+
+    free(sections);
+}
+
+static void MMBenchmarkRunSelection(void)
+{
+    char columns[64];
+    snprintf(columns, sizeof(columns), "%-20s %-10s %-6s %-16s", "selection", "10y", "-", "-");
+
+    // A tenth of ten years selected, the span is set up front so that the operations stay inside it
+    MMCalendarDayNumber firstDayNumber = 20454, numberOfDays = 3653;
+    MMCalendarSelection *selection = [[MMCalendarSelection alloc] init];
+    [selection addDayNumber:firstDayNumber];
+    [selection addDayNumber:firstDayNumber+numberOfDays-1];
+    uint32_t state = 2463534242u;
+    for (NSInteger i = 0; i < numberOfDays/10; i++) {
+        [selection addDayNumber:firstDayNumber + MMBenchmarkRandom(&state) % numberOfDays];
+    }
+    NSUInteger numberOfInputs = 4096;
+    MMCalendarDayNumber *dayNumbers = malloc(sizeof(MMCalendarDayNumber)*numberOfInputs);
+    for (NSUInteger i = 0; i < numberOfInputs; i++) {
+        dayNumbers[i] = firstDayNumber + 1 + MMBenchmarkRandom(&state) % (numberOfDays - MMCalendarMaximumNumberOfDaysInPage - 1);
+    }
+    NSUInteger mask = numberOfInputs - 1;
+
+    // Every visible cell asks whether its day is selected
+    MMBenchmarkMeasure("selectionContains", {
+        MMBenchmarkSink = [selection containsDayNumber:dayNumbers[i & mask]];
+    });
+
+    // A tap selects a day and the next one deselects it
+    MMBenchmarkMeasure("selectionToggle", {
+        MMCalendarDayNumber dayNumber = dayNumbers[i & mask];
+        if (![selection addDayNumber:dayNumber]) [selection removeDayNumber:dayNumber];
+    });
+
+    // A range swipe over a page and back
+    MMBenchmarkMeasure("selectionRange", {
+        MMCalendarDayNumber dayNumber = dayNumbers[i & mask];
+        MMBenchmarkSink = [selection addDayNumbersFromDayNumber:dayNumber toDayNumber:dayNumber+MMCalendarMaximumNumberOfDaysInPage-1];
+        [selection removeDayNumbersFromDayNumber:dayNumber toDayNumber:dayNumber+MMCalendarMaximumNumberOfDaysInPage-1];
+    });
+
+    free(dayNumbers);
+}
+
+#undef MMBenchmarkMeasure
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool {
+        if (argc > 1) {
+            MMBenchmarkIterations = MAX(strtoul(argv[1], NULL, 10), 1);
+        }
+        if (argc > 2 && !MMBenchmarkLoadThresholds(argv[2])) {
+            fprintf(stderr, "Can't read thresholds from %s\n", argv[2]);
+            return 2;
+        }
+        NSArray<NSString *> *identifiers = @[NSCalendarIdentifierGregorian,
+                                             NSCalendarIdentifierIslamicUmmAlQura,
+                                             NSCalendarIdentifierIslamicCivil,
+                                             NSCalendarIdentifierPersian,
+                                             NSCalendarIdentifierHebrew]; // Not native, measures the NSCalendar fallback
+        if (!MMBenchmarkCountsAllocations) {
+            printf("Allocations are only counted with glibc\n");
+        }
+        printf("%-20s %-10s %-6s %-16s %-20s %10s %10s\n", "calendar", "range", "scope", "placeholder", "operation", "ns/op", "allocs/op");
+        MMBenchmarkRunSelection();
+        for (NSString *identifier in identifiers) {
+            for (NSUInteger r = 0; r < MMBenchmarkCount(MMBenchmarkRanges); r++) {
+                for (NSUInteger s = 0; s < MMBenchmarkCount(MMBenchmarkScopeNames); s++) {
+                    for (NSUInteger p = 0; p < MMBenchmarkCount(MMBenchmarkPlaceholders); p++) {
+                        @autoreleasepool {
+                            MMBenchmarkRun(identifier, MMBenchmarkRanges[r], (MMCalendarScope)s, MMBenchmarkPlaceholders[p]);
+                        }
+                    }
+                }
+            }
+        }
+        if (MMBenchmarkNumberOfFailures) {
+            fprintf(stderr, "%lu operations over budget\n", (unsigned long)MMBenchmarkNumberOfFailures);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,199 @@
+//
+//  MMCalendarCalculatorTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendar.h>
+#import <MMCalendar/MMCalendarDynamicHeader.h>
+
+@interface MMCalendarCalculatorTests : XCTestCase <MMCalendarDataSource>
+
+@property (strong, nonatomic) MMCalendar *calendar;
+@property (strong, nonatomic) NSDate *minimumDate;
+@property (strong, nonatomic) NSDate *maximumDate;
+
+@end
+
+@implementation MMCalendarCalculatorTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calendar = [[MMCalendar alloc] initWithFrame:CGRectMake(0, 0, 320, 300)];
+    self.calendar.dataSource = self;
+    self.minimumDate = [self dateWithYear:1900 month:1 day:1];
+    self.maximumDate = [self dateWithYear:2200 month:12 day:31];
+}
+
+- (void)tearDown
+{
+    self.calendar = nil;
+    [super tearDown];
+}
+
+- (NSDate *)minimumDateForCalendar:(MMCalendar *)calendar
+{
+    return self.minimumDate;
+}
+
+- (NSDate *)maximumDateForCalendar:(MMCalendar *)calendar
+{
+    return self.maximumDate;
+}
+
+- (NSDate *)dateWithYear:(NSInteger)year month:(NSInteger)month day:(NSInteger)day
+{
+    return [self.calendar.gregorian dateWithEra:1 year:year month:month day:day hour:0 minute:0 second:0 nanosecond:0];
+}
+
+// The placeholders NSCalendar puts before the first day of the month, as the section table should
+- (NSInteger)headPlaceholdersForMonth:(NSDate *)month
+{
+    NSCalendar *gregorian = self.calendar.gregorian;
+    NSInteger head = ([gregorian component:NSCalendarUnitWeekday fromDate:month] - gregorian.firstWeekday + 7) % 7;
+    if (!head && self.calendar.placeholderType == MMCalendarPlaceholderTypeFillSixRows && !self.calendar.floatingMode) {
+        head = 7;
+    }
+    return head;
+}
+
+- (void)assertMonthSectionsMatchCalendar
+{
+    [self.calendar reloadData];
+    NSCalendar *gregorian = self.calendar.gregorian;
+    MMCalendarCalculator *calculator = self.calendar.calculator;
+    NSInteger numberOfMonths = [gregorian components:NSCalendarUnitMonth fromDate:self.minimumDate toDate:self.maximumDate options:0].month + 1;
+    XCTAssertEqual([calculator numberOfSections], numberOfMonths);
+
+    for (NSInteger section = 0; section < numberOfMonths; section++) {
+        NSDate *month = [gregorian dateByAddingUnit:NSCalendarUnitMonth value:section toDate:self.minimumDate options:0];
+        NSInteger head = [self headPlaceholdersForMonth:month];
+        NSInteger numberOfDays = [gregorian rangeOfUnit:NSCalendarUnitDay inUnit:NSCalendarUnitMonth forDate:month].length;
+        NSInteger numberOfRows = self.calendar.placeholderType == MMCalendarPlaceholderTypeFillSixRows ? 6 : (head + numberOfDays + 6) / 7;
+        NSDate *lastDay = [gregorian dateByAddingUnit:NSCalendarUnitDay value:numberOfDays-1 toDate:month options:0];
+        NSDate *firstCell = [gregorian dateByAddingUnit:NSCalendarUnitDay value:-head toDate:month options:0];
+        NSDate *lastCell = [gregorian dateByAddingUnit:NSCalendarUnitDay value:numberOfRows*7-1 toDate:firstCell options:0];
+
+        // Stop at the first broken month, the following ones would fail the same way
+        BOOL matches = [[calculator monthForSection:section] isEqualToDate:month]
+            && [calculator numberOfRowsInMonth:month] == numberOfRows
+            && [[calculator dateForIndexPath:[NSIndexPath indexPathForItem:0 inSection:section] scope:MMCalendarScopeMonth] isEqualToDate:firstCell]
+            && [[calculator dateForIndexPath:[NSIndexPath indexPathForItem:numberOfRows*7-1 inSection:section] scope:MMCalendarScopeMonth] isEqualToDate:lastCell]
+            && [[calculator indexPathForDate:month scope:MMCalendarScopeMonth] isEqual:[NSIndexPath indexPathForItem:head inSection:section]]
+            && [[calculator indexPathForDate:lastDay scope:MMCalendarScopeMonth] isEqual:[NSIndexPath indexPathForItem:head+numberOfDays-1 inSection:section]];
+        if (!matches) {
+            XCTFail(@"Month section %@ (%@) doesn't match NSCalendar", @(section), month);
+            return;
+        }
+    }
+}
+
+- (void)testMonthSectionsFillingSixRows
+{
+    [self assertMonthSectionsMatchCalendar];
+}
+
+- (void)testMonthSectionsWithoutPlaceholders
+{
+    self.calendar.placeholderType = MMCalendarPlaceholderTypeNone;
+    [self assertMonthSectionsMatchCalendar];
+}
+
+- (void)testMonthSectionsStartingOnMonday
+{
+    self.calendar.firstWeekday = 2;
+    [self assertMonthSectionsMatchCalendar];
+}
+
+- (void)testMonthSectionsWithSmallChunkBudget
+{
+    // Walking three centuries through two chunks evicts and rebuilds every one of them
+    self.calendar.calculator.chunkBudget = 2;
+    [self assertMonthSectionsMatchCalendar];
+}
+
+- (void)testWeekSections
+{
+    [self.calendar reloadData];
+    NSCalendar *gregorian = self.calendar.gregorian;
+    MMCalendarCalculator *calculator = self.calendar.calculator;
+    NSDate *firstWeek;
+    [gregorian rangeOfUnit:NSCalendarUnitWeekOfYear startDate:&firstWeek interval:NULL forDate:self.minimumDate];
+
+    NSArray<NSDate *> *dates = @[[self dateWithYear:1900 month:1 day:1],
+                                 [self dateWithYear:1970 month:1 day:1],
+                                 [self dateWithYear:2000 month:2 day:29],
+                                 [self dateWithYear:2026 month:10 day:17],
+                                 [self dateWithYear:2200 month:12 day:31]];
+    for (NSDate *date in dates) {
+        NSInteger days = [gregorian components:NSCalendarUnitDay fromDate:firstWeek toDate:date options:0].day;
+        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:days % 7 inSection:days / 7];
+        XCTAssertEqualObjects([calculator indexPathForDate:date scope:MMCalendarScopeWeek], indexPath, @"%@", date);
+        XCTAssertEqualObjects([calculator dateForIndexPath:indexPath scope:MMCalendarScopeWeek], date);
+    }
+}
+
+- (void)testDatesBeforeMinimumHaveNoIndexPath
+{
+    [self.calendar reloadData];
+    MMCalendarCalculator *calculator = self.calendar.calculator;
+    XCTAssertNil([calculator indexPathForDate:[self dateWithYear:1899 month:12 day:31] scope:MMCalendarScopeMonth]);
+    XCTAssertNil([calculator indexPathForDate:[self dateWithYear:1899 month:12 day:1] scope:MMCalendarScopeWeek]);
+}
+
+- (void)testSnapshotBuiltInBackgroundMatches
+{
+    NSCalendar *gregorian = self.calendar.gregorian.copy;
+    NSDate *today = [self dateWithYear:2026 month:10 day:17];
+    MMCalendarSnapshot *snapshot = [[MMCalendarSnapshot alloc] initWithCalendar:gregorian minimumDate:self.minimumDate maximumDate:self.maximumDate today:today currentPage:today];
+    __block MMCalendarSnapshot *backgroundSnapshot = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Snapshot"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        backgroundSnapshot = [[MMCalendarSnapshot alloc] initWithCalendar:gregorian minimumDate:self.minimumDate maximumDate:self.maximumDate today:today currentPage:today];
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqual(backgroundSnapshot.table.numberOfMonths, snapshot.table.numberOfMonths);
+    XCTAssertEqual(backgroundSnapshot.weekendMask, snapshot.weekendMask);
+    XCTAssertEqual(backgroundSnapshot.todayDayNumber, snapshot.todayDayNumber);
+    for (NSInteger section = 0; section < snapshot.table.numberOfMonths; section += 97) {
+        XCTAssertEqual([backgroundSnapshot.table monthDayNumberForSection:section], [snapshot.table monthDayNumberForSection:section]);
+    }
+}
+
+- (void)testSnapshotWithTodayKeepsSections
+{
+    NSDate *today = [self dateWithYear:2026 month:10 day:17];
+    MMCalendarSnapshot *snapshot = [[MMCalendarSnapshot alloc] initWithCalendar:self.calendar.gregorian minimumDate:self.minimumDate maximumDate:self.maximumDate today:today currentPage:today];
+    XCTAssertEqual([snapshot snapshotWithToday:today], snapshot);
+
+    NSDate *tomorrow = [self dateWithYear:2026 month:10 day:18];
+    MMCalendarSnapshot *nextSnapshot = [snapshot snapshotWithToday:tomorrow];
+    XCTAssertEqual(nextSnapshot.table, snapshot.table);
+    XCTAssertEqual(nextSnapshot.todayDayNumber, snapshot.todayDayNumber + 1);
+    XCTAssertEqual([snapshot snapshotWithToday:nil].todayDayNumber, NSIntegerMin);
+}
+
+- (void)testReloadSectionsSwapsOnMainThread
+{
+    [self.calendar reloadData];
+    MMCalendarCalculator *calculator = self.calendar.calculator;
+    MMCalendarSnapshot *snapshot = calculator.snapshot;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Reload"];
+    [calculator reloadSectionsWithCompletion:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNotEqual(calculator.snapshot, snapshot);
+        XCTAssertEqual(calculator.numberOfSections, snapshot.table.numberOfMonths);
+        [expectation fulfill];
+    }];
+    // Until the swap the sections in use stay those of the current snapshot
+    XCTAssertEqual(calculator.snapshot, snapshot);
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+@end
@@ -0,0 +1,172 @@
+//
+//  MMCalendarCollectionViewLayoutTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendar.h>
+#import <MMCalendar/MMCalendarDynamicHeader.h>
+
+@interface MMCalendarCollectionViewLayoutTests : XCTestCase
+
+@property (strong, nonatomic) UIWindow *window;
+@property (strong, nonatomic) MMCalendar *calendar;
+
+@end
+
+@implementation MMCalendarCollectionViewLayoutTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 320, 480)];
+    self.calendar = [[MMCalendar alloc] initWithFrame:CGRectMake(0, 0, 320, 300)];
+    [self.window addSubview:self.calendar];
+    [self layoutCalendar];
+}
+
+- (void)tearDown
+{
+    [self.calendar removeFromSuperview];
+    self.calendar = nil;
+    self.window = nil;
+    [super tearDown];
+}
+
+- (void)layoutCalendar
+{
+    [self.calendar setNeedsLayout];
+    [self.calendar layoutIfNeeded];
+    [self.calendar.collectionView layoutIfNeeded];
+}
+
+- (NSArray<NSValue *> *)itemFramesInSection:(NSInteger)section
+{
+    MMCalendarCollectionViewLayout *layout = self.calendar.collectionViewLayout;
+    NSInteger numberOfItems = [self.calendar.collectionView numberOfItemsInSection:section];
+    NSMutableArray<NSValue *> *frames = [NSMutableArray arrayWithCapacity:numberOfItems];
+    for (NSInteger item = 0; item < numberOfItems; item++) {
+        UICollectionViewLayoutAttributes *attributes = [layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:item inSection:section]];
+        [frames addObject:[NSValue valueWithCGRect:attributes.frame]];
+    }
+    return frames;
+}
+
+// Every cell layoutAttributesForElementsInRect: returns matches the per item attributes, and no cell in the rect is missing
+- (void)assertElementsInRect:(CGRect)rect matchItemsInSections:(NSRange)sections
+{
+    MMCalendarCollectionViewLayout *layout = self.calendar.collectionViewLayout;
+    NSMutableSet<NSIndexPath *> *indexPaths = [NSMutableSet set];
+    for (UICollectionViewLayoutAttributes *attributes in [layout layoutAttributesForElementsInRect:rect]) {
+        if (attributes.representedElementCategory != UICollectionElementCategoryCell) continue;
+        UICollectionViewLayoutAttributes *itemAttributes = [layout layoutAttributesForItemAtIndexPath:attributes.indexPath];
+        XCTAssertTrue(CGRectEqualToRect(attributes.frame, itemAttributes.frame), @"%@", attributes.indexPath);
+        [indexPaths addObject:attributes.indexPath];
+    }
+    for (NSInteger section = sections.location; section < NSMaxRange(sections); section++) {
+        NSArray<NSValue *> *frames = [self itemFramesInSection:section];
+        for (NSInteger item = 0; item < frames.count; item++) {
+            CGRect intersection = CGRectIntersection(frames[item].CGRectValue, rect);
+            if (CGRectIsEmpty(intersection)) continue;
+            XCTAssertTrue([indexPaths containsObject:[NSIndexPath indexPathForItem:item inSection:section]], @"Missing item %@ in section %@", @(item), @(section));
+        }
+    }
+}
+
+- (void)testMonthFramesTileEachPage
+{
+    MMCalendarCollectionViewLayout *layout = self.calendar.collectionViewLayout;
+    CGSize size = self.calendar.collectionView.frame.size;
+    UIEdgeInsets insets = layout.sectionInsets;
+    NSInteger numberOfSections = self.calendar.collectionView.numberOfSections;
+    XCTAssertGreaterThan(size.width, 0);
+
+    for (NSNumber *section in @[@0, @(numberOfSections/2), @(numberOfSections-1)]) {
+        NSArray<NSValue *> *frames = [self itemFramesInSection:section.integerValue];
+        XCTAssertEqual(frames.count, 42);
+        CGFloat left = section.integerValue * size.width;
+        XCTAssertEqualWithAccuracy(CGRectGetMinX(frames[0].CGRectValue), left + insets.left, 0.001);
+        XCTAssertEqualWithAccuracy(CGRectGetMaxX(frames[6].CGRectValue), left + size.width - insets.right, 0.001);
+        XCTAssertEqualWithAccuracy(CGRectGetMinY(frames[0].CGRectValue), insets.top, 0.001);
+        XCTAssertEqualWithAccuracy(CGRectGetMaxY(frames[41].CGRectValue), size.height - insets.bottom, 0.001);
+        for (NSInteger item = 0; item < 42; item++) {
+            CGRect frame = frames[item].CGRectValue;
+            if (item % 7 < 6) {
+                XCTAssertEqualWithAccuracy(CGRectGetMaxX(frame), CGRectGetMinX(frames[item+1].CGRectValue), 0.001);
+                XCTAssertEqualWithAccuracy(CGRectGetMinY(frame), CGRectGetMinY(frames[item+1].CGRectValue), 0.001);
+            }
+            if (item < 35) {
+                XCTAssertEqualWithAccuracy(CGRectGetMaxY(frame), CGRectGetMinY(frames[item+7].CGRectValue), 0.001);
+                XCTAssertEqualWithAccuracy(CGRectGetMinX(frame), CGRectGetMinX(frames[item+7].CGRectValue), 0.001);
+            }
+        }
+    }
+}
+
+- (void)testElementsInRectMatchItemAttributes
+{
+    CGSize size = self.calendar.collectionView.frame.size;
+    NSInteger section = self.calendar.collectionView.numberOfSections/2;
+    // Whole pages, then rects sliding across two pages as scrolling asks for them
+    [self assertElementsInRect:CGRectMake(section*size.width, 0, size.width, size.height) matchItemsInSections:NSMakeRange(section, 1)];
+    for (CGFloat offset = 0; offset <= size.width; offset += size.width/8) {
+        CGRect rect = CGRectMake(section*size.width + offset, 0, size.width, size.height);
+        [self assertElementsInRect:rect matchItemsInSections:NSMakeRange(section, 2)];
+    }
+    [self assertElementsInRect:CGRectMake(section*size.width, size.height/3, size.width, size.height/3) matchItemsInSections:NSMakeRange(section, 1)];
+}
+
+- (void)testFramesSurviveReloadData
+{
+    NSInteger section = self.calendar.collectionView.numberOfSections/2;
+    NSArray<NSValue *> *frames = [self itemFramesInSection:section];
+    [self.calendar reloadData];
+    [self layoutCalendar];
+    XCTAssertEqualObjects([self itemFramesInSection:section], frames);
+}
+
+- (void)testFramesSurviveScopeRoundTrip
+{
+    NSInteger section = [self.calendar.calculator indexPathForDate:self.calendar.currentPage scope:MMCalendarScopeMonth].section;
+    NSArray<NSValue *> *frames = [self itemFramesInSection:section];
+
+    [self.calendar setScope:MMCalendarScopeWeek animated:NO];
+    [self layoutCalendar];
+    CGSize size = self.calendar.collectionView.frame.size;
+    UIEdgeInsets insets = self.calendar.collectionViewLayout.sectionInsets;
+    NSArray<NSValue *> *weekFrames = [self itemFramesInSection:0];
+    XCTAssertEqual(weekFrames.count, 7);
+    XCTAssertEqualWithAccuracy(CGRectGetMinY(weekFrames[0].CGRectValue), insets.top, 0.001);
+    XCTAssertEqualWithAccuracy(CGRectGetMaxY(weekFrames[0].CGRectValue), size.height - insets.bottom, 0.001);
+
+    [self.calendar setScope:MMCalendarScopeMonth animated:NO];
+    [self layoutCalendar];
+    XCTAssertEqualObjects([self itemFramesInSection:section], frames);
+}
+
+- (void)testFloatingSectionsStack
+{
+    self.calendar.pagingEnabled = NO;
+    [self layoutCalendar];
+    MMCalendarCollectionViewLayout *layout = self.calendar.collectionViewLayout;
+    NSInteger numberOfSections = self.calendar.collectionView.numberOfSections;
+
+    for (NSNumber *number in @[@0, @1, @(numberOfSections/2), @(numberOfSections-2)]) {
+        NSInteger section = number.integerValue;
+        NSArray<NSValue *> *frames = [self itemFramesInSection:section];
+        XCTAssertEqual(frames.count, [self.calendar.calculator numberOfRowsInSection:section]*7);
+        CGRect header = [layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:[NSIndexPath indexPathForItem:0 inSection:section]].frame;
+        CGRect nextHeader = [layout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:[NSIndexPath indexPathForItem:0 inSection:section+1]].frame;
+        XCTAssertLessThanOrEqual(CGRectGetMaxY(header), CGRectGetMinY(frames.firstObject.CGRectValue) + 0.001);
+        XCTAssertLessThanOrEqual(CGRectGetMaxY(frames.lastObject.CGRectValue), CGRectGetMinY(nextHeader) + 0.001);
+
+        // A screen starting in the middle of the section reaches into the next one
+        CGRect rect = CGRectMake(0, CGRectGetMidY(frames.lastObject.CGRectValue) - 100, self.calendar.collectionView.frame.size.width, 300);
+        [self assertElementsInRect:rect matchItemsInSections:NSMakeRange(section, 2)];
+    }
+}
+
+@end
@@ -0,0 +1,106 @@
+//
+//  MMCalendarDateEngineTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendarDateEngine.h>
+
+@interface MMCalendarDateEngineTests : XCTestCase
+
+@end
+
+@implementation MMCalendarDateEngineTests
+
+- (NSCalendar *)calendarWithIdentifier:(NSCalendarIdentifier)identifier
+{
+    NSCalendar *calendar = [NSCalendar calendarWithIdentifier:identifier];
+    calendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    calendar.firstWeekday = 1;
+    return calendar;
+}
+
+// Walks every day from the first day of fromYear to the first day of toYear, both in the calendar's own years.
+- (void)assertEngineMatchesCalendar:(NSCalendarIdentifier)identifier fromYear:(NSInteger)fromYear toYear:(NSInteger)toYear
+{
+    NSCalendar *calendar = [self calendarWithIdentifier:identifier];
+    MMCalendarDateEngine *engine = [[MMCalendarDateEngine alloc] initWithCalendar:calendar minimumDate:nil];
+    XCTAssertNotEqual(engine.arithmetic, MMCalendarArithmeticSystem, @"%@", identifier);
+
+    NSInteger era = [calendar component:NSCalendarUnitEra fromDate:[NSDate date]];
+    NSDate *fromDate = [calendar dateWithEra:era year:fromYear month:1 day:1 hour:0 minute:0 second:0 nanosecond:0];
+    NSDate *toDate = [calendar dateWithEra:era year:toYear month:1 day:1 hour:0 minute:0 second:0 nanosecond:0];
+    MMCalendarDayNumber firstDayNumber = [engine dayNumberForDate:fromDate];
+    MMCalendarDayNumber lastDayNumber = [engine dayNumberForDate:toDate];
+    XCTAssertEqual(firstDayNumber*86400, (MMCalendarDayNumber)fromDate.timeIntervalSince1970, @"%@", identifier);
+    XCTAssertEqual(lastDayNumber*86400, (MMCalendarDayNumber)toDate.timeIntervalSince1970, @"%@", identifier);
+
+    for (MMCalendarDayNumber dayNumber = firstDayNumber; dayNumber <= lastDayNumber; dayNumber++) {
+        NSDate *date = [engine dateForDayNumber:dayNumber];
+        NSDateComponents *components = [calendar components:NSCalendarUnitYear|NSCalendarUnitMonth|NSCalendarUnitDay fromDate:date];
+        // Stop at the first mismatch, a broken kernel would otherwise report every following day.
+        if ([engine dayOfMonthForDayNumber:dayNumber] != components.day) {
+            XCTFail(@"%@ %@-%@-%@: day %@", identifier, @(components.year), @(components.month), @(components.day), @([engine dayOfMonthForDayNumber:dayNumber]));
+            return;
+        }
+        NSInteger monthOrdinal = [engine monthOrdinalForDayNumber:dayNumber];
+        if ([engine firstDayOfMonthOrdinal:monthOrdinal] != dayNumber - components.day + 1) {
+            XCTFail(@"%@ %@-%@-%@: first day of month", identifier, @(components.year), @(components.month), @(components.day));
+            return;
+        }
+        if (components.day == 1) {
+            NSUInteger numberOfDays = [calendar rangeOfUnit:NSCalendarUnitDay inUnit:NSCalendarUnitMonth forDate:date].length;
+            if ([engine numberOfDaysInMonthOrdinal:monthOrdinal] != numberOfDays) {
+                XCTFail(@"%@ %@-%@: %@ days, expected %@", identifier, @(components.year), @(components.month), @([engine numberOfDaysInMonthOrdinal:monthOrdinal]), @(numberOfDays));
+                return;
+            }
+        }
+        if ([engine dayNumberForDate:[date dateByAddingTimeInterval:43200]] != dayNumber) {
+            XCTFail(@"%@ %@-%@-%@: round trip", identifier, @(components.year), @(components.month), @(components.day));
+            return;
+        }
+    }
+}
+
+- (void)testUmmAlQuraAcrossTableEdges
+{
+    // The table covers 1300-1600 AH, both edges fall back to the civil cycle
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierIslamicUmmAlQura fromYear:1295 toYear:1306];
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierIslamicUmmAlQura fromYear:1420 toYear:1460];
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierIslamicUmmAlQura fromYear:1595 toYear:1606];
+}
+
+- (void)testIslamicCivil
+{
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierIslamicCivil fromYear:1295 toYear:1606];
+}
+
+- (void)testIslamicTabular
+{
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierIslamicTabular fromYear:1295 toYear:1606];
+}
+
+- (void)testPersianLeapYears
+{
+    // Several 33 year cycles, every Esfand of a leap year has 30 days
+    [self assertEngineMatchesCalendar:NSCalendarIdentifierPersian fromYear:1250 toYear:1570];
+}
+
+- (void)testUmmAlQuraOutsideTableMatchesCivil
+{
+    MMCalendarDateEngine *ummAlQura = [[MMCalendarDateEngine alloc] initWithCalendar:[self calendarWithIdentifier:NSCalendarIdentifierIslamicUmmAlQura] minimumDate:nil];
+    MMCalendarDateEngine *civil = [[MMCalendarDateEngine alloc] initWithCalendar:[self calendarWithIdentifier:NSCalendarIdentifierIslamicCivil] minimumDate:nil];
+    MMCalendarDayNumber dayNumbers[] = {
+        MMCalendarGregorianDayNumberFromCivil(1880, 6, 1),
+        MMCalendarGregorianDayNumberFromCivil(2200, 6, 1),
+    };
+    for (NSInteger i = 0; i < sizeof(dayNumbers)/sizeof(dayNumbers[0]); i++) {
+        XCTAssertEqual([ummAlQura monthOrdinalForDayNumber:dayNumbers[i]], [civil monthOrdinalForDayNumber:dayNumbers[i]]);
+        XCTAssertEqual([ummAlQura dayOfMonthForDayNumber:dayNumbers[i]], [civil dayOfMonthForDayNumber:dayNumbers[i]]);
+    }
+}
+
+@end
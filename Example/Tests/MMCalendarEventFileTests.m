@@ -0,0 +1,138 @@
+//
+//  MMCalendarEventFileTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendarEventFile.h>
+
+@interface MMCalendarEventFileTests : XCTestCase
+
+@property (strong, nonatomic) NSString *path;
+
+@end
+
+@implementation MMCalendarEventFileTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    // Written out of order, the writer sorts them
+    MMCalendarEventRecord records[] = {
+        {30, 30, 3},
+        {10, 20, 0},
+        {18, 25, 2},
+        {15, 15, 1}
+    };
+    NSError *error = nil;
+    XCTAssertTrue([MMCalendarEventFile writeRecords:records count:4 toPath:self.path error:&error], @"%@", error);
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+    [super tearDown];
+}
+
+- (void)testRoundTrip
+{
+    NSError *error = nil;
+    MMCalendarEventFile *file = [[MMCalendarEventFile alloc] initWithPath:self.path error:&error];
+    XCTAssertNotNil(file, @"%@", error);
+    XCTAssertEqual(file.version, 1);
+    XCTAssertEqual(file.numberOfEvents, 4);
+    XCTAssertEqual(file.maximumLength, 11);
+    XCTAssertEqual(file.minimumDayNumber, 10);
+    XCTAssertEqual(file.maximumDayNumber, 30);
+    
+    NSInteger expected[][2] = {{9, 0}, {10, 1}, {15, 2}, {17, 1}, {18, 2}, {20, 2}, {21, 1}, {25, 1}, {26, 0}, {30, 1}, {31, 0}};
+    for (NSInteger i = 0; i < sizeof(expected)/sizeof(expected[0]); i++) {
+        XCTAssertEqual([file numberOfEventsForDayNumber:expected[i][0]], expected[i][1], @"day %ld", (long)expected[i][0]);
+    }
+    NSInteger numbers[24];
+    [file getNumberOfEvents:numbers fromDayNumber:8 count:24];
+    for (NSInteger i = 0; i < 24; i++) {
+        XCTAssertEqual(numbers[i], [file numberOfEventsForDayNumber:8+i], @"day %ld", (long)(8+i));
+    }
+    uint32_t colorIndexes[4];
+    XCTAssertEqual([file getColorIndexes:colorIndexes maximumCount:4 forDayNumber:18], 2);
+    XCTAssertEqual(colorIndexes[0], 0);
+    XCTAssertEqual(colorIndexes[1], 2);
+}
+
+- (void)testRoundTripFromCSV
+{
+    NSError *error = nil;
+    NSString *string = @"# first,last,attribute\n1970-01-11,1970-01-21,4\n\n1970-01-16,1970-01-16\n";
+    XCTAssertTrue([MMCalendarEventFile writeRecordsFromCSVString:string toPath:self.path error:&error], @"%@", error);
+    MMCalendarEventFile *file = [[MMCalendarEventFile alloc] initWithPath:self.path error:&error];
+    XCTAssertNotNil(file, @"%@", error);
+    XCTAssertEqual(file.numberOfEvents, 2);
+    XCTAssertEqual([file numberOfEventsForDayNumber:15], 2);
+    XCTAssertEqual([file numberOfEventsForDayNumber:20], 1);
+    XCTAssertEqual([file numberOfEventsForDayNumber:21], 0);
+}
+
+- (void)testRejectsTruncatedHeader
+{
+    NSData *data = [NSData dataWithContentsOfFile:self.path];
+    [[data subdataWithRange:NSMakeRange(0, 20)] writeToFile:self.path atomically:YES];
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarEventFile alloc] initWithPath:self.path error:&error]);
+    XCTAssertEqualObjects(error.domain, MMCalendarEventFileErrorDomain);
+    XCTAssertEqual(error.code, MMCalendarEventFileErrorInvalidFormat);
+}
+
+- (void)testRejectsTruncatedRecords
+{
+    NSData *data = [NSData dataWithContentsOfFile:self.path];
+    [[data subdataWithRange:NSMakeRange(0, data.length-4)] writeToFile:self.path atomically:YES];
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarEventFile alloc] initWithPath:self.path error:&error]);
+    XCTAssertEqual(error.code, MMCalendarEventFileErrorInvalidFormat);
+}
+
+- (void)testRejectsCorruptHeader
+{
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile:self.path];
+    ((uint8_t *)data.mutableBytes)[0] = 'X';
+    [data writeToFile:self.path atomically:YES];
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarEventFile alloc] initWithPath:self.path error:&error]);
+    XCTAssertEqual(error.code, MMCalendarEventFileErrorInvalidFormat);
+    
+    ((uint8_t *)data.mutableBytes)[0] = 'M';
+    ((uint8_t *)data.mutableBytes)[4] = 99; // Version
+    [data writeToFile:self.path atomically:YES];
+    error = nil;
+    XCTAssertNil([[MMCalendarEventFile alloc] initWithPath:self.path error:&error]);
+    XCTAssertEqual(error.code, MMCalendarEventFileErrorUnsupportedVersion);
+}
+
+- (void)testOutOfOrderRecordStaysInsideWindow
+{
+    // The first record starts long after the window it is found in
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile:self.path];
+    int32_t firstDayNumber = CFSwapInt32HostToLittle(1000);
+    [data replaceBytesInRange:NSMakeRange(32, 4) withBytes:&firstDayNumber];
+    [data writeToFile:self.path atomically:YES];
+    NSError *error = nil;
+    MMCalendarEventFile *file = [[MMCalendarEventFile alloc] initWithPath:self.path error:&error];
+    XCTAssertNotNil(file, @"%@", error);
+    NSInteger numbers[24];
+    [file getNumberOfEvents:numbers fromDayNumber:8 count:24];
+    XCTAssertEqual(numbers[2], 0);
+}
+
+- (void)testMissingFileIsUnreadable
+{
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarEventFile alloc] initWithPath:[self.path stringByAppendingString:@".missing"] error:&error]);
+    XCTAssertEqual(error.code, MMCalendarEventFileErrorUnreadable);
+}
+
+@end
@@ -0,0 +1,101 @@
+//
+//  MMCalendarEventStoreTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendarEventStore.h>
+
+// Whole days in UTC, the last day included
+static MMCalendarEvent MMCalendarTestEvent(MMCalendarDayNumber firstDayNumber, MMCalendarDayNumber lastDayNumber, uint64_t identifier, uint32_t colorIndex)
+{
+    MMCalendarEvent event = {firstDayNumber*86400.0, (lastDayNumber+1)*86400.0, identifier, colorIndex};
+    return event;
+}
+
+@interface MMCalendarEventStoreTests : XCTestCase
+
+@property (strong, nonatomic) MMCalendarEventStore *store;
+
+@end
+
+@implementation MMCalendarEventStoreTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.store = [[MMCalendarEventStore alloc] initWithTimeZone:[NSTimeZone timeZoneWithName:@"UTC"]];
+    MMCalendarEvent events[] = {
+        MMCalendarTestEvent(10, 20, 1, 0),
+        MMCalendarTestEvent(15, 15, 2, 1),
+        MMCalendarTestEvent(18, 25, 3, 2),
+        MMCalendarTestEvent(30, 30, 4, 3)
+    };
+    [self.store loadEvents:events count:4];
+}
+
+- (void)testCountsOverlappingEvents
+{
+    XCTAssertEqual(self.store.numberOfEvents, 4);
+    NSInteger expected[][2] = {{9, 0}, {10, 1}, {15, 2}, {17, 1}, {18, 2}, {20, 2}, {21, 1}, {25, 1}, {26, 0}, {30, 1}, {31, 0}};
+    for (NSInteger i = 0; i < sizeof(expected)/sizeof(expected[0]); i++) {
+        XCTAssertEqual([self.store numberOfEventsForDayNumber:expected[i][0]], expected[i][1], @"day %ld", (long)expected[i][0]);
+    }
+}
+
+- (void)testCountsRangeLikeSingleDays
+{
+    NSInteger numbers[24];
+    [self.store getNumberOfEvents:numbers fromDayNumber:8 count:24];
+    for (NSInteger i = 0; i < 24; i++) {
+        XCTAssertEqual(numbers[i], [self.store numberOfEventsForDayNumber:8+i], @"day %ld", (long)(8+i));
+    }
+}
+
+- (void)testEventEndingAtMidnightLeavesNextDay
+{
+    MMCalendarEvent event = {40*86400.0, 41*86400.0, 5, 0};
+    [self.store addEvent:event];
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:40], 1);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:41], 0);
+}
+
+- (void)testCountsAfterInsertAndRemove
+{
+    MMCalendarEvent event = MMCalendarTestEvent(12, 19, 6, 4);
+    [self.store addEvent:event];
+    XCTAssertEqual(self.store.numberOfEvents, 5);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:11], 1);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:15], 3);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:19], 3);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:20], 2);
+    
+    XCTAssertTrue([self.store removeEvent:event]);
+    XCTAssertFalse([self.store removeEvent:event]);
+    XCTAssertEqual(self.store.numberOfEvents, 4);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:15], 2);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:19], 2);
+    
+    // Same day, another identifier
+    XCTAssertFalse([self.store removeEvent:MMCalendarTestEvent(15, 15, 7, 1)]);
+    XCTAssertTrue([self.store removeEvent:MMCalendarTestEvent(15, 15, 2, 1)]);
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:15], 1);
+    
+    [self.store removeAllEvents];
+    XCTAssertEqual([self.store numberOfEventsForDayNumber:20], 0);
+}
+
+- (void)testColorIndexesStartWithEarliestEvent
+{
+    uint32_t colorIndexes[4];
+    XCTAssertEqual([self.store getColorIndexes:colorIndexes maximumCount:4 forDayNumber:18], 2);
+    XCTAssertEqual(colorIndexes[0], 0);
+    XCTAssertEqual(colorIndexes[1], 2);
+    XCTAssertEqual([self.store getColorIndexes:colorIndexes maximumCount:1 forDayNumber:18], 1);
+    XCTAssertEqual(colorIndexes[0], 0);
+}
+
+@end
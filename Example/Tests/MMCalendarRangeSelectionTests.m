@@ -0,0 +1,170 @@
+//
+//  MMCalendarRangeSelectionTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendar.h>
+#import <MMCalendar/MMCalendarDynamicHeader.h>
+
+@interface MMCalendarSingleDateDelegate : NSObject <MMCalendarDelegate>
+
+@property (strong, nonatomic) NSMutableArray<NSDate *> *dates;
+
+@end
+
+@implementation MMCalendarSingleDateDelegate
+
+- (void)calendar:(MMCalendar *)calendar didSelectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    [self.dates addObject:date];
+}
+
+@end
+
+@interface MMCalendarRangeSelectionTests : XCTestCase <MMCalendarDelegate>
+
+@property (strong, nonatomic) MMCalendar *calendar;
+@property (strong, nonatomic) NSMutableArray<NSArray<NSDate *> *> *selectedDateGroups;
+
+@end
+
+@implementation MMCalendarRangeSelectionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.calendar = [[MMCalendar alloc] initWithFrame:CGRectMake(0, 0, 320, 300)];
+    self.calendar.allowsMultipleSelection = YES;
+    self.calendar.delegate = self;
+    self.selectedDateGroups = [NSMutableArray array];
+}
+
+- (void)tearDown
+{
+    self.calendar = nil;
+    [super tearDown];
+}
+
+- (void)calendar:(MMCalendar *)calendar didSelectDates:(NSArray<NSDate *> *)dates
+{
+    [self.selectedDateGroups addObject:dates];
+}
+
+- (NSDate *)dateWithYear:(NSInteger)year month:(NSInteger)month day:(NSInteger)day
+{
+    return [self.calendar.gregorian dateWithEra:1 year:year month:month day:day hour:0 minute:0 second:0 nanosecond:0];
+}
+
+- (NSArray<NSDate *> *)datesFromYear:(NSInteger)year month:(NSInteger)month day:(NSInteger)firstDay toDay:(NSInteger)lastDay
+{
+    NSMutableArray<NSDate *> *dates = [NSMutableArray array];
+    for (NSInteger day = firstDay; day <= lastDay; day++) {
+        [dates addObject:[self dateWithYear:year month:month day:day]];
+    }
+    return dates;
+}
+
+- (void)testRangeIsReportedOnce
+{
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:5] toDate:[self dateWithYear:2026 month:10 day:9]];
+    NSArray<NSDate *> *dates = [self datesFromYear:2026 month:10 day:5 toDay:9];
+    XCTAssertEqualObjects(self.selectedDateGroups, @[dates]);
+    XCTAssertEqualObjects(self.calendar.selectedDates, dates);
+}
+
+- (void)testReversedRange
+{
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:9] toDate:[self dateWithYear:2026 month:10 day:5]];
+    XCTAssertEqualObjects(self.calendar.selectedDates, [self datesFromYear:2026 month:10 day:5 toDay:9]);
+}
+
+- (void)testOnlyNewDatesAreReported
+{
+    [self.calendar selectDate:[self dateWithYear:2026 month:10 day:7] scrollToDate:NO];
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:5] toDate:[self dateWithYear:2026 month:10 day:9]];
+    NSArray<NSDate *> *dates = @[[self dateWithYear:2026 month:10 day:5],
+                                 [self dateWithYear:2026 month:10 day:6],
+                                 [self dateWithYear:2026 month:10 day:8],
+                                 [self dateWithYear:2026 month:10 day:9]];
+    XCTAssertEqualObjects(self.selectedDateGroups, @[dates]);
+
+    // Nothing new, nothing to tell
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:6] toDate:[self dateWithYear:2026 month:10 day:8]];
+    XCTAssertEqual(self.selectedDateGroups.count, 1);
+}
+
+- (void)testSingleDateDelegateHearsEveryDate
+{
+    MMCalendarSingleDateDelegate *delegate = [[MMCalendarSingleDateDelegate alloc] init];
+    delegate.dates = [NSMutableArray array];
+    self.calendar.delegate = delegate;
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:9 day:29] toDate:[self dateWithYear:2026 month:10 day:2]];
+    NSArray<NSDate *> *dates = @[[self dateWithYear:2026 month:9 day:29],
+                                 [self dateWithYear:2026 month:9 day:30],
+                                 [self dateWithYear:2026 month:10 day:1],
+                                 [self dateWithYear:2026 month:10 day:2]];
+    XCTAssertEqualObjects(delegate.dates, dates);
+}
+
+- (void)testRangeNeedsMultipleSelection
+{
+    self.calendar.allowsMultipleSelection = NO;
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:5] toDate:[self dateWithYear:2026 month:10 day:9]];
+    XCTAssertEqual(self.calendar.selectedDates.count, 0);
+    XCTAssertEqual(self.selectedDateGroups.count, 0);
+}
+
+- (void)testDeselectingInsideRange
+{
+    [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:5] toDate:[self dateWithYear:2026 month:10 day:9]];
+    [self.calendar deselectDate:[self dateWithYear:2026 month:10 day:7]];
+    NSArray<NSDate *> *dates = @[[self dateWithYear:2026 month:10 day:5],
+                                 [self dateWithYear:2026 month:10 day:6],
+                                 [self dateWithYear:2026 month:10 day:8],
+                                 [self dateWithYear:2026 month:10 day:9]];
+    XCTAssertEqualObjects(self.calendar.selectedDates, dates);
+}
+
+- (void)testBatchAppliesEveryUpdate
+{
+    [self.calendar selectDate:[self dateWithYear:2026 month:10 day:1] scrollToDate:NO];
+    [self.calendar performBatchSelectionUpdates:^{
+        [self.calendar selectDatesFromDate:[self dateWithYear:2026 month:10 day:5] toDate:[self dateWithYear:2026 month:10 day:7]];
+        [self.calendar deselectDate:[self dateWithYear:2026 month:10 day:1]];
+        [self.calendar deselectDate:[self dateWithYear:2026 month:10 day:6]];
+        [self.calendar selectDate:[self dateWithYear:2026 month:10 day:20] scrollToDate:NO];
+    }];
+    NSArray<NSDate *> *dates = @[[self dateWithYear:2026 month:10 day:5],
+                                 [self dateWithYear:2026 month:10 day:7],
+                                 [self dateWithYear:2026 month:10 day:20]];
+    XCTAssertEqualObjects(self.calendar.selectedDates, dates);
+}
+
+- (void)testNestedBatches
+{
+    [self.calendar performBatchSelectionUpdates:^{
+        [self.calendar selectDate:[self dateWithYear:2026 month:10 day:5] scrollToDate:NO];
+        [self.calendar performBatchSelectionUpdates:^{
+            [self.calendar selectDate:[self dateWithYear:2026 month:10 day:6] scrollToDate:NO];
+        }];
+        XCTAssertTrue([self.calendar.selectedDates containsObject:[self dateWithYear:2026 month:10 day:6]]);
+        [self.calendar selectDate:[self dateWithYear:2026 month:10 day:7] scrollToDate:NO];
+    }];
+    XCTAssertEqualObjects(self.calendar.selectedDates, [self datesFromYear:2026 month:10 day:5 toDay:7]);
+}
+
+- (void)testBatchKeepsLastDateWithoutMultipleSelection
+{
+    self.calendar.allowsMultipleSelection = NO;
+    [self.calendar performBatchSelectionUpdates:^{
+        [self.calendar selectDate:[self dateWithYear:2026 month:10 day:5] scrollToDate:NO];
+        [self.calendar selectDate:[self dateWithYear:2026 month:10 day:9] scrollToDate:NO];
+    }];
+    XCTAssertEqualObjects(self.calendar.selectedDates, @[[self dateWithYear:2026 month:10 day:9]]);
+}
+
+@end
@@ -0,0 +1,159 @@
+//
+//  MMCalendarRecurrenceTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendarRecurrence.h>
+
+@interface MMCalendarRecurrenceTests : XCTestCase
+
+@end
+
+@implementation MMCalendarRecurrenceTests
+
+- (NSArray<NSNumber *> *)dayNumbersOfRule:(NSString *)rule firstDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber
+{
+    NSError *error = nil;
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:rule firstDayNumber:firstDayNumber error:&error];
+    XCTAssertNotNil(recurrence, @"%@", error);
+    NSMutableArray<NSNumber *> *dayNumbers = [NSMutableArray array];
+    [recurrence enumerateDayNumbersFromDayNumber:firstDayNumber toDayNumber:lastDayNumber usingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+        [dayNumbers addObject:@(dayNumber)];
+    }];
+    return dayNumbers;
+}
+
+- (void)testLastWeekdayWithNegativeSetPosition
+{
+    NSArray<NSNumber *> *dayNumbers = [self dayNumbersOfRule:@"FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1"
+                                              firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 1, 30)
+                                                 toDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 4, 1)];
+    NSArray<NSNumber *> *expected = @[@(MMCalendarGregorianDayNumberFromCivil(2026, 1, 30)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2026, 2, 27)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2026, 3, 31))];
+    XCTAssertEqualObjects(dayNumbers, expected);
+}
+
+- (void)testPositiveAndNegativeSetPositions
+{
+    // The first and the last Monday of each month
+    NSArray<NSNumber *> *dayNumbers = [self dayNumbersOfRule:@"RRULE:FREQ=MONTHLY;BYDAY=MO;BYSETPOS=1,-1"
+                                              firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 3, 2)
+                                                 toDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 4, 30)];
+    NSArray<NSNumber *> *expected = @[@(MMCalendarGregorianDayNumberFromCivil(2026, 3, 2)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2026, 3, 30)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2026, 4, 6)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2026, 4, 27))];
+    XCTAssertEqualObjects(dayNumbers, expected);
+}
+
+- (void)testNegativeMonthDayFollowsMonthLength
+{
+    NSArray<NSNumber *> *dayNumbers = [self dayNumbersOfRule:@"FREQ=MONTHLY;BYMONTHDAY=-1"
+                                              firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2024, 1, 31)
+                                                 toDayNumber:MMCalendarGregorianDayNumberFromCivil(2024, 4, 30)];
+    NSArray<NSNumber *> *expected = @[@(MMCalendarGregorianDayNumberFromCivil(2024, 1, 31)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2024, 2, 29)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2024, 3, 31)),
+                                      @(MMCalendarGregorianDayNumberFromCivil(2024, 4, 30))];
+    XCTAssertEqualObjects(dayNumbers, expected);
+}
+
+- (void)testCountGivesLastDayNumber
+{
+    NSError *error = nil;
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=MONTHLY;BYMONTHDAY=-2;COUNT=3" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 1, 30) error:&error];
+    XCTAssertNotNil(recurrence, @"%@", error);
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2026, 3, 30));
+    
+    recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=WEEKLY;BYDAY=MO" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 1, 5) error:&error];
+    XCTAssertEqual(recurrence.lastDayNumber, NSIntegerMax);
+}
+
+- (void)testCountReachesOccurrencesYearsApart
+{
+    // Leap days on a Friday are 28 years apart here
+    NSError *error = nil;
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;BYMONTH=2;BYMONTHDAY=29;BYDAY=FR;COUNT=2" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2008, 2, 29) error:&error];
+    XCTAssertNotNil(recurrence, @"%@", error);
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2036, 2, 29));
+}
+
+- (void)testExcludedDaysAreLeftOut
+{
+    NSError *error = nil;
+    MMCalendarDayNumber firstDayNumber = MMCalendarGregorianDayNumberFromCivil(2026, 10, 1);
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;COUNT=3" firstDayNumber:firstDayNumber error:&error];
+    [recurrence.excludedDayNumbers addDayNumber:firstDayNumber+1];
+    NSMutableArray<NSNumber *> *dayNumbers = [NSMutableArray array];
+    [recurrence enumerateDayNumbersFromDayNumber:firstDayNumber toDayNumber:firstDayNumber+10 usingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+        [dayNumbers addObject:@(dayNumber)];
+    }];
+    XCTAssertEqualObjects(dayNumbers, (@[@(firstDayNumber), @(firstDayNumber+2)]));
+}
+
+- (void)testRejectsRules
+{
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarRecurrence alloc] initWithRule:@"FREQ=HOURLY" firstDayNumber:0 error:&error]);
+    XCTAssertEqualObjects(error.domain, MMCalendarRecurrenceErrorDomain);
+    XCTAssertEqual(error.code, MMCalendarRecurrenceErrorUnsupportedRule);
+    
+    error = nil;
+    XCTAssertNil([[MMCalendarRecurrence alloc] initWithRule:@"FREQ=MONTHLY;BYMONTHDAY=32" firstDayNumber:0 error:&error]);
+    XCTAssertEqual(error.code, MMCalendarRecurrenceErrorInvalidRule);
+}
+
+- (void)testCountWithoutPartsSkipsShortMonths
+{
+    NSError *error = nil;
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=MONTHLY;COUNT=8" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 1, 31) error:&error];
+    XCTAssertNotNil(recurrence, @"%@", error);
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2027, 1, 31));
+
+    // 2100 is not a leap year
+    recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=YEARLY;COUNT=3" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2096, 2, 29) error:&error];
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2108, 2, 29));
+
+    recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=WEEKLY;INTERVAL=2;COUNT=3" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2026, 10, 5) error:&error];
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2026, 11, 2));
+}
+
+- (void)testLargeCountWithoutParts
+{
+    NSError *error = nil;
+    MMCalendarRecurrence *recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;COUNT=2000000000" firstDayNumber:0 error:&error];
+    XCTAssertNotNil(recurrence, @"%@", error);
+    XCTAssertEqual(recurrence.lastDayNumber, 1999999999);
+
+    recurrence = [[MMCalendarRecurrence alloc] initWithRule:@"FREQ=YEARLY;COUNT=2000000000" firstDayNumber:MMCalendarGregorianDayNumberFromCivil(2000, 1, 1) error:&error];
+    XCTAssertEqual(recurrence.lastDayNumber, MMCalendarGregorianDayNumberFromCivil(2000001999, 1, 1));
+}
+
+- (void)testLongestInterval
+{
+    NSArray<NSNumber *> *dayNumbers = [self dayNumbersOfRule:@"FREQ=DAILY;INTERVAL=146097" firstDayNumber:0 toDayNumber:1000000];
+    XCTAssertEqualObjects(dayNumbers, (@[@0, @146097, @292194, @438291, @584388, @730485, @876582]));
+}
+
+- (void)testRejectsLargeIntervalAndCount
+{
+    NSError *error = nil;
+    XCTAssertNil([[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;INTERVAL=9223372036854775807" firstDayNumber:0 error:&error]);
+    XCTAssertEqual(error.code, MMCalendarRecurrenceErrorInvalidRule);
+
+    error = nil;
+    XCTAssertNil([[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;INTERVAL=146098" firstDayNumber:0 error:&error]);
+    XCTAssertEqual(error.code, MMCalendarRecurrenceErrorInvalidRule);
+
+    // Counting these one by one would take too long
+    error = nil;
+    XCTAssertNil([[MMCalendarRecurrence alloc] initWithRule:@"FREQ=DAILY;BYDAY=MO;COUNT=2000000000" firstDayNumber:0 error:&error]);
+    XCTAssertEqual(error.code, MMCalendarRecurrenceErrorUnsupportedRule);
+}
+
+@end
@@ -0,0 +1,112 @@
+//
+//  MMCalendarSelectionTests.m
+//  MMCalendarTests
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+@import XCTest;
+#import <MMCalendar/MMCalendarSelection.h>
+
+@interface MMCalendarSelectionTests : XCTestCase
+
+@property (strong, nonatomic) MMCalendarSelection *selection;
+
+@end
+
+@implementation MMCalendarSelectionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.selection = [[MMCalendarSelection alloc] init];
+}
+
+- (NSArray<NSNumber *> *)dayNumbers
+{
+    NSMutableArray<NSNumber *> *dayNumbers = [NSMutableArray array];
+    [self.selection enumerateDayNumbersUsingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+        [dayNumbers addObject:@(dayNumber)];
+    }];
+    return dayNumbers;
+}
+
+- (void)testSingleDaysAtWordBoundaries
+{
+    XCTAssertEqual(self.selection.lastDayNumber, NSIntegerMin);
+    for (NSNumber *dayNumber in @[@64, @63, @128, @127, @-1, @-64, @-65]) {
+        XCTAssertTrue([self.selection addDayNumber:dayNumber.integerValue]);
+    }
+    XCTAssertFalse([self.selection addDayNumber:64]);
+    XCTAssertEqual(self.selection.count, 7);
+    XCTAssertTrue([self.selection containsDayNumber:-65]);
+    XCTAssertFalse([self.selection containsDayNumber:0]);
+    XCTAssertFalse([self.selection containsDayNumber:65]);
+    XCTAssertFalse([self.selection containsDayNumber:1000]);
+    XCTAssertEqualObjects([self dayNumbers], (@[@-65, @-64, @-1, @63, @64, @127, @128]));
+    
+    XCTAssertTrue([self.selection removeDayNumber:64]);
+    XCTAssertFalse([self.selection removeDayNumber:64]);
+    XCTAssertFalse([self.selection removeDayNumber:1000]);
+    XCTAssertEqual(self.selection.count, 6);
+    XCTAssertFalse([self.selection containsDayNumber:64]);
+}
+
+- (void)testRangesAcrossWords
+{
+    [self.selection addDayNumber:63];
+    [self.selection addDayNumber:128];
+    XCTAssertEqual([self.selection addDayNumbersFromDayNumber:60 toDayNumber:130], 69);
+    XCTAssertEqual(self.selection.count, 71);
+    XCTAssertEqual(self.selection.lastDayNumber, 130);
+    XCTAssertFalse([self.selection containsDayNumber:59]);
+    XCTAssertTrue([self.selection containsDayNumber:60]);
+    XCTAssertTrue([self.selection containsDayNumber:130]);
+    XCTAssertFalse([self.selection containsDayNumber:131]);
+    
+    XCTAssertEqual([self.selection removeDayNumbersFromDayNumber:64 toDayNumber:127], 64);
+    XCTAssertEqual(self.selection.count, 7);
+    XCTAssertEqualObjects([self dayNumbers], (@[@60, @61, @62, @63, @128, @129, @130]));
+    
+    // The latest day goes, the latest one left takes its place
+    XCTAssertEqual([self.selection removeDayNumbersFromDayNumber:129 toDayNumber:1000], 2);
+    XCTAssertEqual(self.selection.lastDayNumber, 128);
+}
+
+- (void)testNegativeRange
+{
+    XCTAssertEqual([self.selection addDayNumbersFromDayNumber:-130 toDayNumber:-60], 71);
+    XCTAssertTrue([self.selection containsDayNumber:-128]);
+    XCTAssertTrue([self.selection containsDayNumber:-65]);
+    XCTAssertFalse([self.selection containsDayNumber:-59]);
+    XCTAssertEqual([self.selection removeDayNumbersFromDayNumber:-1000 toDayNumber:-65], 66);
+    XCTAssertEqualObjects([self dayNumbers], (@[@-64, @-63, @-62, @-61, @-60]));
+}
+
+- (void)testLastDayNumberIsMostRecentlyAdded
+{
+    [self.selection addDayNumber:100];
+    [self.selection addDayNumber:50];
+    XCTAssertEqual(self.selection.lastDayNumber, 50);
+    [self.selection removeDayNumber:50];
+    XCTAssertEqual(self.selection.lastDayNumber, 100);
+    
+    // Deselecting steps back in selection order, not to the latest day
+    [self.selection addDayNumber:20];
+    [self.selection addDayNumber:200];
+    [self.selection addDayNumber:10];
+    [self.selection removeDayNumber:10];
+    XCTAssertEqual(self.selection.lastDayNumber, 200);
+    [self.selection removeDayNumber:200];
+    XCTAssertEqual(self.selection.lastDayNumber, 20);
+    // Already selected, nothing moves
+    XCTAssertFalse([self.selection addDayNumber:100]);
+    XCTAssertEqual(self.selection.lastDayNumber, 20);
+    [self.selection removeAllDayNumbers];
+    XCTAssertEqual(self.selection.count, 0);
+    XCTAssertEqual(self.selection.lastDayNumber, NSIntegerMin);
+    XCTAssertFalse([self.selection containsDayNumber:100]);
+}
+
+@end
@@ -19,6 +19,11 @@
 #import "MMCalendarCell.h"
 #import "MMCalendarWeekdayView.h"
 #import "MMCalendarHeaderView.h"
+#import "MMCalendarSectionTable.h"
+#import "MMCalendarDayContent.h"
+#import "MMCalendarEventStore.h"
+#import "MMCalendarEventFile.h"
+#import "MMCalendarRecurrence.h"
 
 //! Project version number for MMCalendar.
 FOUNDATION_EXPORT double MMCalendarVersionNumber;
@@ -26,11 +31,6 @@ FOUNDATION_EXPORT double MMCalendarVersionNumber;
 //! Project version string for MMCalendar.
 FOUNDATION_EXPORT const unsigned char MMCalendarVersionString[];
 
-typedef NS_ENUM(NSUInteger, MMCalendarScope) {
-    MMCalendarScopeMonth,
-    MMCalendarScopeWeek
-};
-
 typedef NS_ENUM(NSUInteger, MMCalendarScrollDirection) {
     MMCalendarScrollDirectionVertical,
     MMCalendarScrollDirectionHorizontal
@@ -42,14 +42,6 @@ typedef NS_ENUM(NSUInteger, MMCalendarPlaceholderType) {
     MMCalendarPlaceholderTypeFillSixRows   = 2
 };
 
-typedef NS_ENUM(NSUInteger, MMCalendarMonthPosition) {
-    MMCalendarMonthPositionPrevious,
-    MMCalendarMonthPositionCurrent,
-    MMCalendarMonthPositionNext,
-    
-    MMCalendarMonthPositionNotFound = NSNotFound
-};
-
 NS_ASSUME_NONNULL_BEGIN
 
 @class MMCalendar;
@@ -105,6 +97,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)calendar:(MMCalendar *)calendar hasEventForDate:(NSDate *)date MMCalendarDeprecated(-calendar:numberOfEventsForDate:);
 
+/**
+ * Asks the dataSource for the title, subtitle, image and number of events of every day in a page at once. contents[i] stands for the i-th day from the start of the range, one record per day.
+ *
+ * When implemented, the calendar doesn't ask for titleForDate, subtitleForDate, imageForDate or numberOfEventsForDate. A page is asked for again after -reloadData.
+ */
+- (void)calendar:(MMCalendar *)calendar contentForDatesInRange:(NSDateInterval *)range into:(NSArray<MMCalendarDayContent *> *)contents;
+
+/**
+ * Asks the dataSource to fill the content of a page that is about to be shown: the current page and the ones before and after it. contents[i] stands for the i-th day from the start of the range.
+ *
+ * The records may be filled on any queue. Call the completion from any queue once done, the calendar only reads the records after that. The progress is cancelled when the calendar pages away or reloads, the completion may then be skipped.
+ * Pages not prefetched in time are asked for with calendar:contentForDatesInRange:into: if implemented, or date by date.
+ */
+- (void)calendar:(MMCalendar *)calendar prefetchContentForDatesInRange:(NSDateInterval *)range into:(NSArray<MMCalendarDayContent *> *)contents progress:(NSProgress *)progress completion:(void (^)(void))completion;
+
 @end
 
 
@@ -125,6 +132,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)calendar:(MMCalendar *)calendar didSelectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition;
 
+/**
+ Tells the delegate the dates of a range are selected, once for the whole range. The dates selected before are not included.
+ */
+- (void)calendar:(MMCalendar *)calendar didSelectDates:(NSArray<NSDate *> *)dates;
+
 /**
  Asks the delegate whether the specific date is allowed to be deselected by tapping.
  */
@@ -278,6 +290,12 @@ IB_DESIGNABLE
  */
 @property (weak, nonatomic) IBOutlet id<MMCalendarDataSource> dataSource;
 
+/**
+ * Events to show as dots, an MMCalendarEventStore, an MMCalendarEventFile or an MMCalendarRecurringEventSource. When set, the number of events and the default event colors of every day come from here instead of the data source and the delegate.
+ * Changes to an MMCalendarEventStore reload only the cells of the days they touch.
+ */
+@property (strong, nonatomic, nullable) id<MMCalendarEventSource> eventStore;
+
 /**
  * A special mark will be put on 'today' of the calendar.
  */
@@ -389,6 +407,11 @@ IB_DESIGNABLE
  */
 @property (assign, nonatomic) IBInspectable BOOL allowsMultipleSelection;
 
+/**
+ A Boolean value that determines whether swipe-to-choose selects every date between the pressed date and the one under the finger. Needs allowsMultipleSelection. Default is NO.
+ */
+@property (assign, nonatomic) IBInspectable BOOL allowsRangeSelection;
+
 /**
  A Boolean value that determines whether paging is enabled for the calendar.
  */
@@ -415,6 +438,11 @@ IB_DESIGNABLE
  */
 @property (assign, nonatomic) IBInspectable BOOL showsScopeHandle MMCalendarDeprecated(handleScopeGesture:);
 
+/**
+ A Boolean value that determines whether a scope gesture drags snapshots of the days instead of the cells, which come back when the finger lifts. The delegate is told about the new bounds once, when the gesture ends, instead of on every move, so while a gesture grows the calendar the days are drawn past its bottom edge. Default is NO.
+ */
+@property (assign, nonatomic) IBInspectable BOOL usesSnapshotsForScopeGesture;
+
 /**
  The row height of the calendar if paging enabled is NO.;
  */
@@ -436,12 +464,14 @@ IB_DESIGNABLE
 @property (readonly, nonatomic) NSDate *maximumDate;
 
 /**
- A date object identifying the section of the selected date. (read-only)
+ The most recently selected date that is still selected. Deselecting it goes back to the one selected before, through the last 16 selections; past them, the latest selected date. (read-only)
  */
 @property (nullable, readonly, nonatomic) NSDate *selectedDate;
 
 /**
- The dates representing the selected dates. (read-only)
+ The dates representing the selected dates, in ascending order. (read-only)
+ 
+ @warning Earlier versions listed them in the order they were selected. Use selectedDate for the most recent one.
  */
 @property (readonly, nonatomic) NSArray<NSDate *> *selectedDates;
 
@@ -450,6 +480,44 @@ IB_DESIGNABLE
  */
 - (void)reloadData;
 
+/**
+ Asks the data source and the delegate again about the given dates, and reconfigures their visible cells in place without dequeuing new ones. Only the cached pages holding these dates are asked for again, other cells are left alone.
+ 
+ @param dates The dates whose content or appearance changed.
+ */
+- (void)reloadDates:(NSArray<NSDate *> *)dates;
+
+/**
+ Reloads every date of the page containing the given date, in the current scope, like -reloadDates:.
+ 
+ @param page A date in the page to reload.
+ */
+- (void)reloadPage:(NSDate *)page;
+
+/**
+ Forgets what MMCalendarDelegateAppearance answered for the given dates and asks again for the visible ones. Answers are kept per day until then, or until -reloadData.
+ 
+ @param dates The dates whose appearance changed.
+ */
+- (void)invalidateAppearanceForDates:(NSArray<NSDate *> *)dates;
+
+/**
+ Forgets what MMCalendarDelegateAppearance answered for every date and asks again for the visible ones.
+ */
+- (void)invalidateAllAppearance;
+
+/**
+ Same as -invalidateAppearanceForDates:, named after -reloadDates:.
+ 
+ @param dates The dates whose appearance changed.
+ */
+- (void)reloadAppearanceForDates:(NSArray<NSDate *> *)dates;
+
+/**
+ Same as -invalidateAllAppearance, named after -reloadDates:.
+ */
+- (void)reloadAllAppearance;
+
 /**
  Change the scope of the calendar. Make sure `-calendar:boundingRectWillChange:animated` is correctly adopted.
  
@@ -473,6 +541,25 @@ IB_DESIGNABLE
  */
 - (void)selectDate:(nullable NSDate *)date scrollToDate:(BOOL)scrollToDate;
 
+/**
+ Selects every date from one date to another, both included. Does nothing unless allowsSelection and allowsMultipleSelection are both on.
+ 
+ The delegate is told once with calendar:didSelectDates: about the dates that weren't selected before, or with calendar:didSelectDate:atMonthPosition: for each of them if it only implements that.
+ 
+ @param fromDate The first date of the range.
+ @param toDate The last date of the range.
+ */
+- (void)selectDatesFromDate:(NSDate *)fromDate toDate:(NSDate *)toDate;
+
+/**
+ Applies the selections and deselections made in the block together. Each visible cell whose state changed is reconfigured once, after the block returns.
+ 
+ Dates selected in the block are treated as dates of the current month, and only the last one asking for it is scrolled to. Batches can be nested.
+ 
+ @param updates A block calling selectDate:, deselectDate: or selectDatesFromDate:toDate:.
+ */
+- (void)performBatchSelectionUpdates:(void (NS_NOESCAPE ^)(void))updates;
+
 /**
  Deselects a given date of the calendar.
  
@@ -20,6 +20,8 @@
 
 #import "MMCalendarTransitionCoordinator.h"
 #import "MMCalendarCalculator.h"
+#import "MMCalendarSelection.h"
+#import "MMCalendarDayAppearance.h"
 #import "MMCalendarDelegationFactory.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -39,8 +41,26 @@ static inline void MMCalendarAssertDateInBounds(NSDate *date, NSCalendar *calend
     }
 }
 
+// A page of prefetched content is named by its first day number and its number of days, which is at most MMCalendarMaximumNumberOfDaysInPage
+static const NSInteger MMCalendarPrefetchKeyStride = 64;
+
+static inline NSNumber *MMCalendarPrefetchKey(MMCalendarDayNumber firstDayNumber, NSInteger count) {
+    return @(firstDayNumber*MMCalendarPrefetchKeyStride + count);
+}
+
+static inline NSInteger MMCalendarPrefetchKeyCount(NSNumber *key) {
+    NSInteger value = key.integerValue % MMCalendarPrefetchKeyStride;
+    return value < 0 ? value+MMCalendarPrefetchKeyStride : value;
+}
+
+static inline MMCalendarDayNumber MMCalendarPrefetchKeyFirstDayNumber(NSNumber *key) {
+    return (key.integerValue - MMCalendarPrefetchKeyCount(key)) / MMCalendarPrefetchKeyStride;
+}
+
 NS_ASSUME_NONNULL_END
 
+#define MMCalendarNumberOfCachedContentPages 4
+
 typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     MMCalendarOrientationLandscape,
     MMCalendarOrientationPortrait
@@ -48,7 +68,15 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 @interface MMCalendar ()<UICollectionViewDataSource, UICollectionViewDelegate, UIGestureRecognizerDelegate>
 {
-    NSMutableArray  *_selectedDates;
+    MMCalendarSelection *_selection;
+    NSArray<NSDate *> *_selectedDates; // Built from _selection when first asked for, nil after every change
+
+    // Pages filled by calendar:contentForDatesInRange:into:, the records of a page are reused for the next one
+    NSMutableArray<NSArray<MMCalendarDayContent *> *> *_contentPages;
+    MMCalendarDayNumber _contentFirstDayNumbers[MMCalendarNumberOfCachedContentPages];
+    NSInteger _contentCounts[MMCalendarNumberOfCachedContentPages];
+    NSUInteger _contentLastAccesses[MMCalendarNumberOfCachedContentPages];
+    NSUInteger _contentAccessCount;
 }
 
 @property (strong, nonatomic) NSCalendar *gregorian;
@@ -86,9 +114,26 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 @property (strong, nonatomic) MMCalendarDelegationProxy  *delegateProxy;
 
 @property (strong, nonatomic) NSIndexPath *lastPressedIndexPath;
+
+// Range selection by swiping, the days added since the gesture began are reported once it ends
+@property (assign, nonatomic) MMCalendarDayNumber rangeAnchorDayNumber;
+@property (strong, nonatomic) MMCalendarSelection *rangeSelection;
+// Days the delegate refused during the current range gesture, not asked again
+@property (strong, nonatomic) MMCalendarSelection *refusedRangeDayNumbers;
+
+// Inside performBatchSelectionUpdates: only the selection changes, cells catch up when the outermost batch ends
+@property (assign, nonatomic) NSInteger numberOfBatchSelectionUpdates;
+@property (strong, nonatomic) NSDate *batchScrollDate;
 @property (strong, nonatomic) NSMapTable *visibleSectionHeaders;
 
+// Pages being prefetched, keyed by MMCalendarPrefetchKey
+@property (strong, nonatomic) NSMutableDictionary<NSNumber *, NSProgress *> *prefetchProgresses;
+
+// Resolved MMCalendarDelegateAppearance answers by day number
+@property (strong, nonatomic) NSCache<NSNumber *, MMCalendarDayAppearance *> *appearanceCache;
+
 - (void)orientationDidChange:(NSNotification *)notification;
+- (void)eventStoreDidChange:(NSNotification *)notification;
 
 - (CGSize)sizeThatFits:(CGSize)size scope:(MMCalendarScope)scope;
 
@@ -103,11 +148,19 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 - (void)selectDate:(NSDate *)date scrollToDate:(BOOL)scrollToDate atMonthPosition:(MMCalendarMonthPosition)monthPosition;
 - (void)enqueueSelectedDate:(NSDate *)date;
+- (BOOL)shouldSelectDayNumber:(MMCalendarDayNumber)dayNumber;
+- (void)extendRangeSelectionToDayNumber:(MMCalendarDayNumber)dayNumber;
+- (void)reloadSelectionForVisibleCells;
+- (void)reloadAppearanceForVisibleCellsInDayNumbers:(nullable MMCalendarSelection *)dayNumbers;
+- (void)reloadDayNumbers:(MMCalendarSelection *)dayNumbers;
 
 - (void)invalidateDateTools;
+- (void)invalidateSectionsWithCompletion:(void (^)(void))completion;
+- (void)invalidateGregorian:(NSCalendar *)gregorian today:(nullable NSDate *)today currentPage:(nullable NSDate *)currentPage completion:(void (^)(void))completion;
 - (void)invalidateLayout;
 - (void)invalidateHeaders;
-- (void)invalidateAppearanceForCell:(MMCalendarCell *)cell forDate:(NSDate *)date;
+- (void)invalidateAppearanceForCell:(MMCalendarCell *)cell forDate:(NSDate *)date dayNumber:(MMCalendarDayNumber)dayNumber;
+- (nullable NSArray<UIColor *> *)eventColorsForDayNumber:(MMCalendarDayNumber)dayNumber;
 
 - (void)invalidateViewFrames;
 
@@ -117,6 +170,12 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)deselectCounterpartDate:(NSDate *)date;
 
 - (void)reloadDataForCell:(MMCalendarCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+- (nullable MMCalendarDayContent *)contentForDayNumber:(MMCalendarDayNumber)dayNumber atIndexPath:(NSIndexPath *)indexPath;
+- (void)invalidateContents;
+- (void)invalidateContentsInDayNumbers:(MMCalendarSelection *)dayNumbers;
+- (void)prefetchContentForSections:(NSIndexSet *)sections cancellingOthers:(BOOL)cancellingOthers;
+- (void)prefetchContentAroundCurrentPage;
+- (void)installContents:(NSArray<MMCalendarDayContent *> *)contents firstDayNumber:(MMCalendarDayNumber)firstDayNumber;
 
 - (void)adjustMonthPosition;
 - (BOOL)requestBoundingDatesIfNecessary;
@@ -202,12 +261,25 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     
     _scrollDirection = MMCalendarScrollDirectionHorizontal;
     _scope = MMCalendarScopeMonth;
-    if (!_selectedDates) {
-        _selectedDates = [NSMutableArray arrayWithCapacity:1];
+    if (!_selection) {
+        _selection = [[MMCalendarSelection alloc] init];
     }
     if (!_visibleSectionHeaders) {
         _visibleSectionHeaders = [NSMapTable weakToWeakObjectsMapTable];
     }
+    if (!_contentPages) {
+        _contentPages = [NSMutableArray arrayWithCapacity:MMCalendarNumberOfCachedContentPages];
+        for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+            [_contentPages addObject:@[]];
+        }
+    }
+    if (!_prefetchProgresses) {
+        _prefetchProgresses = [NSMutableDictionary dictionary];
+    }
+    if (!_appearanceCache) {
+        _appearanceCache = [[NSCache alloc] init];
+        _appearanceCache.countLimit = MMCalendarMaximumNumberOfDaysInPage*8; // The current page and a few on either side
+    }
     
     if (!_dataSourceProxy) {
         _pagingEnabled = YES;
@@ -299,6 +371,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     self.collectionView.dataSource = nil;
     
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIDeviceOrientationDidChangeNotification object:nil];
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:MMCalendarEventStoreDidChangeNotification object:nil];
 }
 
 #pragma mark - Overriden methods
@@ -425,7 +498,8 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     NSDate *date = [NSDate date];
     NSDateComponents *components = [self.gregorian components:NSCalendarUnitYear|NSCalendarUnitMonth|NSCalendarUnitDay fromDate:date];
     components.day = _appearance.fakedSelectedDay?:1;
-    [_selectedDates addObject:[self.gregorian dateFromComponents:components]];
+    [_selection addDayNumber:[self.calculator dayNumberForDate:[self.gregorian dateFromComponents:components]]];
+    _selectedDates = nil;
     [self.collectionView reloadData];
 }
 #endif
@@ -498,7 +572,8 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 - (UICollectionViewCell *)collectionView:(UICollectionView *)collectionView cellForItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    MMCalendarMonthPosition monthPosition = [self.calculator monthPositionForIndexPath:indexPath];
+    MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+    MMCalendarMonthPosition monthPosition = dayInfo.monthPosition;
     
     switch (self.placeholderType) {
         case MMCalendarPlaceholderTypeNone: {
@@ -537,7 +612,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         }
     }
 
-    NSDate *date = [self.calculator dateForIndexPath:indexPath];
+    NSDate *date = [self.calculator dateForDayNumber:dayInfo.dayNumber];
     MMCalendarCell *cell = [self.dataSourceProxy calendar:self cellForDate:date atMonthPosition:monthPosition];
     if (!cell) {
         cell = [self.collectionView dequeueReusableCellWithReuseIdentifier:MMCalendarDefaultCellReuseIdentifier forIndexPath:indexPath];
@@ -568,7 +643,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 //                [stickyHeader setTransform:CGAffineTransformMakeScale(-1,1)];
             }
             
-            stickyHeader.month = [self.gregorian dateByAddingUnit:NSCalendarUnitMonth value:indexPath.section toDate:[self.gregorian fs_firstDayOfMonth:_minimumDate] options:0];
+            stickyHeader.month = [self.calculator monthForSection:indexPath.section];
             self.visibleSectionHeaders[indexPath] = stickyHeader;
             [stickyHeader setNeedsLayout];
             return stickyHeader;
@@ -612,7 +687,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
             [collectionView selectItemAtIndexPath:indexPath animated:NO scrollPosition:UICollectionViewScrollPositionNone];
         }
     }
-    if (![_selectedDates containsObject:selectedDate]) {
+    if (![_selection containsDayNumber:[self.calculator dayNumberForDate:selectedDate]]) {
         cell.selected = YES;
         [cell performSelecting];
     }
@@ -648,7 +723,9 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     cell.selected = NO;
     [cell configureAppearance];
     
-    [_selectedDates removeObject:selectedDate];
+    if ([_selection removeDayNumber:[self.calculator dayNumberForDate:selectedDate]]) {
+        _selectedDates = nil;
+    }
     [self.delegateProxy calendar:self didDeselectDate:selectedDate atMonthPosition:monthPosition];
     [self deselectCounterpartDate:selectedDate];
     
@@ -659,9 +736,9 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     if (![cell isKindOfClass:[MMCalendarCell class]]) {
         return;
     }
-    NSDate *date = [self.calculator dateForIndexPath:indexPath];
-    MMCalendarMonthPosition monthPosition = [self.calculator monthPositionForIndexPath:indexPath];
-    [self.delegateProxy calendar:self willDisplayCell:(MMCalendarCell *)cell forDate:date atMonthPosition:monthPosition];
+    MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+    NSDate *date = [self.calculator dateForDayNumber:dayInfo.dayNumber];
+    [self.delegateProxy calendar:self willDisplayCell:(MMCalendarCell *)cell forDate:date atMonthPosition:dayInfo.monthPosition];
 }
 
 #pragma mark - <UIScrollViewDelegate>
@@ -678,7 +755,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         CGPoint significantPoint = CGPointMake(_collectionView.fs_width*0.5,MIN(self.collectionViewLayout.estimatedItemSize.height*2.75, _collectionView.fs_height*0.5)+_collectionView.contentOffset.y);
         NSIndexPath *significantIndexPath = [_collectionView indexPathForItemAtPoint:significantPoint];
         if (significantIndexPath) {
-            currentPage = [self.gregorian dateByAddingUnit:NSCalendarUnitMonth value:significantIndexPath.section toDate:[self.gregorian fs_firstDayOfMonth:_minimumDate] options:0];
+            currentPage = [self.calculator monthForSection:significantIndexPath.section];
         } else {
             MMCalendarStickyHeader *significantHeader = [self.visibleStickyHeaders filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(MMCalendarStickyHeader * _Nonnull evaluatedObject, NSDictionary<NSString *,id> * _Nullable bindings) {
                 return CGRectContainsPoint(evaluatedObject.frame, significantPoint);
@@ -692,6 +769,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
             [self willChangeValueForKey:@"currentPage"];
             _currentPage = currentPage;
             [self.delegateProxy calendarCurrentPageDidChange:self];
+            [self prefetchContentAroundCurrentPage];
             [self didChangeValueForKey:@"currentPage"];
         }
         
@@ -750,6 +828,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         [self willChangeValueForKey:@"currentPage"];
         _currentPage = targetPage;
         [self.delegateProxy calendarCurrentPageDidChange:self];
+        [self prefetchContentAroundCurrentPage];
         if (_placeholderType != MMCalendarPlaceholderTypeFillSixRows) {
             [self.transitionCoordinator performBoundingRectTransitionFromMonth:lastPage toMonth:_currentPage duration:0.25];
         }
@@ -789,6 +868,30 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     self.orientation = self.currentCalendarOrientation;
 }
 
+- (void)eventStoreDidChange:(NSNotification *)notification
+{
+    if (![NSThread isMainThread]) {
+        // Cells are only touched on the main thread, whichever thread the store was changed on
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self eventStoreDidChange:notification];
+        });
+        return;
+    }
+    NSNumber *firstDayNumber = notification.userInfo[MMCalendarEventStoreFirstDayNumberKey];
+    NSNumber *lastDayNumber = notification.userInfo[MMCalendarEventStoreLastDayNumberKey];
+    MMCalendarDayNumber first = firstDayNumber ? firstDayNumber.integerValue : NSIntegerMin;
+    MMCalendarDayNumber last = lastDayNumber ? lastDayNumber.integerValue : NSIntegerMax;
+    for (NSIndexPath *indexPath in self.collectionView.indexPathsForVisibleItems) {
+        MMCalendarCell *cell = (MMCalendarCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        if (![cell isKindOfClass:[MMCalendarCell class]]) continue;
+        MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+        if (dayInfo.dayNumber < first || dayInfo.dayNumber > last) continue;
+        cell.numberOfEvents = [_eventStore numberOfEventsForDayNumber:dayInfo.dayNumber];
+        [self invalidateAppearanceForCell:cell forDate:[self.calculator dateForDayNumber:dayInfo.dayNumber] dayNumber:dayInfo.dayNumber];
+        [cell configureAppearance];
+    }
+}
+
 #pragma mark - Properties
 
 - (void)setCalendarIdentifier:(NSString *)identifier{
@@ -802,16 +905,16 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 //        [self setTransform:CGAffineTransformMakeScale(-1,1)];
     }
     
-    _today = [calendar dateBySettingHour:0 minute:0 second:0 ofDate:[NSDate date] options:0];
+    NSDate *today = [calendar dateBySettingHour:0 minute:0 second:0 ofDate:[NSDate date] options:0];
+    NSDate *currentPage = [calendar fs_firstDayOfMonth:today];
     
-    self.gregorian = calendar;
-    _currentPage = [calendar fs_firstDayOfMonth:_today];
-    
-    [self invalidateDateTools];
-    [self configureAppearance];
-    if (self.hasValidateVisibleLayout) {
-        [self invalidateHeaders];
-    }
+    [self invalidateGregorian:calendar today:today currentPage:currentPage completion:^{
+        if (self.hasValidateVisibleLayout) {
+            [self.collectionView reloadData];
+            [self invalidateHeaders];
+        }
+        [self configureAppearance];
+    }];
 }
 
 - (NSString *)calendarIdentifier{
@@ -859,12 +962,14 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     if (_firstWeekday != firstWeekday) {
         _firstWeekday = firstWeekday;
         _needsRequestingBoundingDates = YES;
-        [self invalidateDateTools];
-        [self invalidateHeaders];
-        [self.collectionView reloadData];
-        [self configureAppearance];
-        
-        [self invalidateLayout];
+        NSCalendar *gregorian = (self.calculator.pendingCalendar ?: self.gregorian).copy;
+        [self invalidateGregorian:gregorian today:nil currentPage:nil completion:^{
+            [self invalidateHeaders];
+            [self.collectionView reloadData];
+            [self configureAppearance];
+            
+            [self invalidateLayout];
+        }];
     }
 }
 
@@ -876,6 +981,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         MMCalendarAssertDateInBounds(today,self.gregorian,self.minimumDate,self.maximumDate);
         _today = [self.gregorian dateBySettingHour:0 minute:0 second:0 ofDate:today options:0];
     }
+    [self.calculator reloadToday];
     if (self.hasValidateVisibleLayout) {
         [self.visibleCells makeObjectsPerformSelector:@selector(setDateIsToday:) withObject:nil];
         if (today) [[_collectionView cellForItemAtIndexPath:[self.calculator indexPathForDate:today]] setValue:@YES forKey:@"dateIsToday"];
@@ -984,14 +1090,32 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 {
     if (![_locale isEqual:locale]) {
         _locale = locale.copy;
-        [self invalidateDateTools];
-        [self configureAppearance];
-        if (self.hasValidateVisibleLayout) {
-            [self invalidateHeaders];
-        }
+        NSCalendar *gregorian = (self.calculator.pendingCalendar ?: self.gregorian).copy;
+        [self invalidateGregorian:gregorian today:nil currentPage:nil completion:^{
+            [self configureAppearance];
+            if (self.hasValidateVisibleLayout) {
+                [self.collectionView reloadData];
+                [self invalidateHeaders];
+            }
+        }];
     }
 }
 
+- (void)setEventStore:(id<MMCalendarEventSource>)eventStore
+{
+    if (_eventStore == eventStore) return;
+    if (_eventStore) {
+        [[NSNotificationCenter defaultCenter] removeObserver:self name:MMCalendarEventStoreDidChangeNotification object:_eventStore];
+    }
+    _eventStore = eventStore;
+    if (eventStore) {
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(eventStoreDidChange:) name:MMCalendarEventStoreDidChangeNotification object:eventStore];
+    }
+    // Event colors are resolved from the delegate only without a store
+    [self.appearanceCache removeAllObjects];
+    [self.collectionView reloadData];
+}
+
 - (void)setAllowsMultipleSelection:(BOOL)allowsMultipleSelection
 {
     _collectionView.allowsMultipleSelection = allowsMultipleSelection;
@@ -1050,12 +1174,20 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 - (NSDate *)selectedDate
 {
-    return _selectedDates.lastObject;
+    if (!_selection.count) return nil;
+    return [self.calculator dateForDayNumber:_selection.lastDayNumber];
 }
 
 - (NSArray *)selectedDates
 {
-    return [NSArray arrayWithArray:_selectedDates];
+    if (!_selectedDates) {
+        NSMutableArray<NSDate *> *selectedDates = [NSMutableArray arrayWithCapacity:_selection.count];
+        [_selection enumerateDayNumbersUsingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+            [selectedDates addObject:[self.calculator dateForDayNumber:dayNumber]];
+        }];
+        _selectedDates = selectedDates.copy;
+    }
+    return _selectedDates;
 }
 
 - (CGFloat)preferredHeaderHeight
@@ -1154,6 +1286,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)setDataSource:(id<MMCalendarDataSource>)dataSource
 {
     self.dataSourceProxy.delegation = dataSource;
+    [self invalidateContents];
 }
 
 - (id<MMCalendarDataSource>)dataSource
@@ -1164,6 +1297,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)setDelegate:(id<MMCalendarDelegate>)delegate
 {
     self.delegateProxy.delegation = delegate;
+    [self.appearanceCache removeAllObjects];
 }
 
 - (id<MMCalendarDelegate>)delegate
@@ -1176,10 +1310,64 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)reloadData
 {
     _needsRequestingBoundingDates = YES;
+    [self invalidateContents];
+    [self.appearanceCache removeAllObjects];
     if ([self requestBoundingDatesIfNecessary] || !self.collectionView.indexPathsForVisibleItems.count) {
         [self invalidateHeaders];
     }
     [self.collectionView reloadData];
+    [self prefetchContentAroundCurrentPage];
+}
+
+- (void)reloadDates:(NSArray<NSDate *> *)dates
+{
+    if (!dates.count) return;
+    MMCalendarSelection *dayNumbers = [[MMCalendarSelection alloc] init];
+    for (NSDate *date in dates) {
+        [dayNumbers addDayNumber:[self.calculator dayNumberForDate:date]];
+    }
+    [self reloadDayNumbers:dayNumbers];
+}
+
+- (void)reloadPage:(NSDate *)page
+{
+    MMCalendarScope scope = self.transitionCoordinator.representingScope;
+    NSIndexPath *indexPath = [self.calculator indexPathForDate:page scope:scope];
+    if (!indexPath) return;
+    NSInteger section = indexPath.section;
+    MMCalendarDayNumber firstDayNumber = scope == MMCalendarScopeMonth ? [self.calculator monthHeadDayNumberForSection:section] : [self.calculator weekDayNumberForSection:section];
+    NSInteger count = scope == MMCalendarScopeMonth ? MMCalendarMaximumNumberOfDaysInPage : 7;
+    MMCalendarSelection *dayNumbers = [[MMCalendarSelection alloc] init];
+    [dayNumbers addDayNumbersFromDayNumber:firstDayNumber toDayNumber:firstDayNumber+count-1];
+    [self reloadDayNumbers:dayNumbers];
+}
+
+- (void)invalidateAppearanceForDates:(NSArray<NSDate *> *)dates
+{
+    if (!dates.count) return;
+    MMCalendarSelection *dayNumbers = [[MMCalendarSelection alloc] init];
+    for (NSDate *date in dates) {
+        MMCalendarDayNumber dayNumber = [self.calculator dayNumberForDate:date];
+        [dayNumbers addDayNumber:dayNumber];
+        [self.appearanceCache removeObjectForKey:@(dayNumber)];
+    }
+    [self reloadAppearanceForVisibleCellsInDayNumbers:dayNumbers];
+}
+
+- (void)invalidateAllAppearance
+{
+    [self.appearanceCache removeAllObjects];
+    [self reloadAppearanceForVisibleCellsInDayNumbers:nil];
+}
+
+- (void)reloadAppearanceForDates:(NSArray<NSDate *> *)dates
+{
+    [self invalidateAppearanceForDates:dates];
+}
+
+- (void)reloadAllAppearance
+{
+    [self invalidateAllAppearance];
 }
 
 - (void)setScope:(MMCalendarScope)scope animated:(BOOL)animated
@@ -1227,10 +1415,11 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)deselectDate:(NSDate *)date
 {
     date = [self.gregorian dateBySettingHour:0 minute:0 second:0 ofDate:date options:0];
-    if (![_selectedDates containsObject:date]) {
+    if (![_selection removeDayNumber:[self.calculator dayNumberForDate:date]]) {
         return;
     }
-    [_selectedDates removeObject:date];
+    _selectedDates = nil;
+    if (self.numberOfBatchSelectionUpdates) return;
     [self deselectCounterpartDate:date];
     NSIndexPath *indexPath = [self.calculator indexPathForDate:date];
     if ([_collectionView.indexPathsForSelectedItems containsObject:indexPath]) {
@@ -1241,6 +1430,63 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     }
 }
 
+- (void)performBatchSelectionUpdates:(void (NS_NOESCAPE ^)(void))updates
+{
+    self.numberOfBatchSelectionUpdates++;
+    if (updates) updates();
+    self.numberOfBatchSelectionUpdates--;
+    if (self.numberOfBatchSelectionUpdates) return;
+    
+    [self reloadSelectionForVisibleCells];
+    NSDate *scrollDate = self.batchScrollDate;
+    self.batchScrollDate = nil;
+    if (scrollDate) {
+        [self scrollToPageForDate:scrollDate animated:YES];
+    }
+}
+
+- (void)selectDatesFromDate:(NSDate *)fromDate toDate:(NSDate *)toDate
+{
+    if (!self.allowsSelection || !self.allowsMultipleSelection || !fromDate || !toDate) return;
+    
+    [self requestBoundingDatesIfNecessary];
+    
+    MMCalendarAssertDateInBounds(fromDate,self.gregorian,self.minimumDate,self.maximumDate);
+    MMCalendarAssertDateInBounds(toDate,self.gregorian,self.minimumDate,self.maximumDate);
+    
+    MMCalendarDayNumber firstDayNumber = [self.calculator dayNumberForDate:fromDate];
+    MMCalendarDayNumber lastDayNumber = [self.calculator dayNumberForDate:toDate];
+    if (firstDayNumber > lastDayNumber) {
+        MMCalendarDayNumber dayNumber = firstDayNumber;
+        firstDayNumber = lastDayNumber;
+        lastDayNumber = dayNumber;
+    }
+    // Dates are only made for a delegate that is told about them, and only for the days newly selected
+    BOOL notifiesDates = [self.delegateProxy respondsToSelector:@selector(calendar:didSelectDates:)];
+    BOOL notifiesDate = !notifiesDates && [self.delegateProxy respondsToSelector:@selector(calendar:didSelectDate:atMonthPosition:)];
+    NSMutableArray<NSDate *> *dates = nil;
+    if (notifiesDates || notifiesDate) {
+        dates = [NSMutableArray array];
+        for (MMCalendarDayNumber dayNumber = firstDayNumber; dayNumber <= lastDayNumber; dayNumber++) {
+            if (![_selection containsDayNumber:dayNumber]) {
+                [dates addObject:[self.calculator dateForDayNumber:dayNumber]];
+            }
+        }
+    }
+    [_selection addDayNumbersFromDayNumber:firstDayNumber toDayNumber:lastDayNumber];
+    _selectedDates = nil;
+    [self reloadSelectionForVisibleCells];
+    if (!dates.count) return;
+    if (notifiesDates) {
+        [self.delegateProxy calendar:self didSelectDates:dates];
+    } else {
+        // Delegates written before range selection still hear about every date
+        for (NSDate *date in dates) {
+            [self.delegateProxy calendar:self didSelectDate:date atMonthPosition:MMCalendarMonthPositionCurrent];
+        }
+    }
+}
+
 - (void)selectDate:(NSDate *)date scrollToDate:(BOOL)scrollToDate atMonthPosition:(MMCalendarMonthPosition)monthPosition
 {
     if (!self.allowsSelection || !date) return;
@@ -1250,6 +1496,15 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     MMCalendarAssertDateInBounds(date,self.gregorian,self.minimumDate,self.maximumDate);
     
     NSDate *targetDate = [self.gregorian dateBySettingHour:0 minute:0 second:0 ofDate:date options:0];
+    
+    if (self.numberOfBatchSelectionUpdates) {
+        [self enqueueSelectedDate:targetDate];
+        if (scrollToDate) {
+            self.batchScrollDate = targetDate;
+        }
+        return;
+    }
+    
     NSIndexPath *targetIndexPath = [self.calculator indexPathForDate:targetDate];
     
     BOOL shouldSelect = YES;
@@ -1379,6 +1634,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
             }
             if (self.hasValidateVisibleLayout) {
                 [self.delegateProxy calendarCurrentPageDidChange:self];
+                [self prefetchContentAroundCurrentPage];
                 if (_placeholderType != MMCalendarPlaceholderTypeFillSixRows && self.transitionCoordinator.state == MMCalendarTransitionStateIdle) {
                     [self.transitionCoordinator performBoundingRectTransitionFromMonth:lastPage toMonth:_currentPage duration:0.33];
                 }
@@ -1394,10 +1650,8 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 - (BOOL)isDateInRange:(NSDate *)date
 {
-    BOOL flag = YES;
-    flag &= [self.gregorian components:NSCalendarUnitDay fromDate:date toDate:self.minimumDate options:0].day <= 0;
-    flag &= [self.gregorian components:NSCalendarUnitDay fromDate:date toDate:self.maximumDate options:0].day >= 0;;
-    return flag;
+    MMCalendarDayNumber dayNumber = [self.calculator dayNumberForDate:date];
+    return dayNumber >= self.calculator.minimumDayNumber && dayNumber <= self.calculator.maximumDayNumber;
 }
 
 - (BOOL)isPageInRange:(NSDate *)page
@@ -1428,7 +1682,7 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 - (BOOL)isDateSelected:(NSDate *)date
 {
-    return [_selectedDates containsObject:date] || [_collectionView.indexPathsForSelectedItems containsObject:[self.calculator indexPathForDate:date]];
+    return [_selection containsDayNumber:[self.calculator dayNumberForDate:date]] || [_collectionView.indexPathsForSelectedItems containsObject:[self.calculator indexPathForDate:date]];
 }
 
 - (BOOL)isDateInDifferentPage:(NSDate *)date
@@ -1465,6 +1719,37 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     _formatter.locale = _locale;
 }
 
+- (void)invalidateSectionsWithCompletion:(void (^)(void))completion
+{
+    // Without visible pages there is nothing to keep responsive, the new sections are needed right away
+    if (!self.hasValidateVisibleLayout) {
+        [self.calculator reloadSections];
+        [self invalidateContents];
+        [self.appearanceCache removeAllObjects];
+        completion();
+        return;
+    }
+    [self.calculator reloadSectionsWithCompletion:^{
+        // Day numbers may stand for other dates now
+        [self invalidateContents];
+        [self.appearanceCache removeAllObjects];
+        completion();
+    }];
+}
+
+- (void)invalidateGregorian:(NSCalendar *)gregorian today:(NSDate *)today currentPage:(NSDate *)currentPage completion:(void (^)(void))completion
+{
+    // The calendar and the dates derived from it change together with the sections, until then scrolling keeps using the old ones
+    void (^swap)(void) = ^{
+        self.gregorian = gregorian;
+        if (today) self->_today = today;
+        if (currentPage) self->_currentPage = currentPage;
+        [self invalidateDateTools];
+    };
+    [self.calculator prepareCalendar:gregorian currentPage:currentPage swap:swap];
+    [self invalidateSectionsWithCompletion:completion];
+}
+
 - (void)invalidateLayout
 {
     if (!self.floatingMode) {
@@ -1537,6 +1822,10 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     _preferredRowHeight = MMCalendarAutomaticDimension;
     _needsAdjustingViewFrame = YES;
     [self setNeedsLayout];
+    
+    MMCalendarCollectionViewLayoutInvalidationContext *context = [[MMCalendarCollectionViewLayoutInvalidationContext alloc] init];
+    context.invalidations = MMCalendarLayoutInvalidationRows;
+    [_collectionViewLayout invalidateLayoutWithContext:context];
 }
 
 - (void)invalidateHeaders
@@ -1545,46 +1834,82 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     [self.visibleStickyHeaders makeObjectsPerformSelector:@selector(configureAppearance)];
 }
 
-- (void)invalidateAppearanceForCell:(MMCalendarCell *)cell forDate:(NSDate *)date
+- (void)invalidateAppearanceForCell:(MMCalendarCell *)cell forDate:(NSDate *)date dayNumber:(MMCalendarDayNumber)dayNumber
 {
+    MMCalendarDayAppearanceParts parts = MMCalendarDayAppearancePartBase;
+    if (cell.subtitle) parts |= MMCalendarDayAppearancePartSubtitle;
+    if (cell.numberOfEvents) parts |= MMCalendarDayAppearancePartEvent;
+    if (cell.image) parts |= MMCalendarDayAppearancePartImage;
+    
+    MMCalendarDayAppearance *dayAppearance = [self.appearanceCache objectForKey:@(dayNumber)];
+    if (!dayAppearance) {
+        dayAppearance = [[MMCalendarDayAppearance alloc] init];
+        [self.appearanceCache setObject:dayAppearance forKey:@(dayNumber)];
+    }
+    MMCalendarDayAppearanceParts missingParts = parts & ~dayAppearance.resolvedParts;
+    
 #define MMCalendarInvalidateCellAppearance(SEL1,SEL2) \
-    cell.SEL1 = [self.delegateProxy calendar:self appearance:self.appearance SEL2:date];
+    dayAppearance.SEL1 = [self.delegateProxy calendar:self appearance:self.appearance SEL2:date];
     
 #define MMCalendarInvalidateCellAppearanceWithDefault(SEL1,SEL2,DEFAULT) \
     if ([self.delegateProxy respondsToSelector:@selector(calendar:appearance:SEL2:)]) { \
-        cell.SEL1 = [self.delegateProxy calendar:self appearance:self.appearance SEL2:date]; \
+        dayAppearance.SEL1 = [self.delegateProxy calendar:self appearance:self.appearance SEL2:date]; \
     } else { \
-        cell.SEL1 = DEFAULT; \
+        dayAppearance.SEL1 = DEFAULT; \
     }
     
-    MMCalendarInvalidateCellAppearance(preferredFillDefaultColor,fillDefaultColorForDate);
-    MMCalendarInvalidateCellAppearance(preferredFillSelectionColor,fillSelectionColorForDate);
-    MMCalendarInvalidateCellAppearance(preferredTitleDefaultColor,titleDefaultColorForDate);
-    MMCalendarInvalidateCellAppearance(preferredTitleSelectionColor,titleSelectionColorForDate);
-
-    MMCalendarInvalidateCellAppearanceWithDefault(preferredTitleOffset,titleOffsetForDate,CGPointInfinity);
-    if (cell.subtitle) {
+    if (missingParts & MMCalendarDayAppearancePartBase) {
+        MMCalendarInvalidateCellAppearance(preferredFillDefaultColor,fillDefaultColorForDate);
+        MMCalendarInvalidateCellAppearance(preferredFillSelectionColor,fillSelectionColorForDate);
+        MMCalendarInvalidateCellAppearance(preferredTitleDefaultColor,titleDefaultColorForDate);
+        MMCalendarInvalidateCellAppearance(preferredTitleSelectionColor,titleSelectionColorForDate);
+        MMCalendarInvalidateCellAppearanceWithDefault(preferredTitleOffset,titleOffsetForDate,CGPointInfinity);
+        MMCalendarInvalidateCellAppearance(preferredBorderDefaultColor,borderDefaultColorForDate);
+        MMCalendarInvalidateCellAppearance(preferredBorderSelectionColor,borderSelectionColorForDate);
+        MMCalendarInvalidateCellAppearanceWithDefault(preferredBorderRadius,borderRadiusForDate,-1);
+    }
+    if (missingParts & MMCalendarDayAppearancePartSubtitle) {
         MMCalendarInvalidateCellAppearance(preferredSubtitleDefaultColor,subtitleDefaultColorForDate);
         MMCalendarInvalidateCellAppearance(preferredSubtitleSelectionColor,subtitleSelectionColorForDate);
         MMCalendarInvalidateCellAppearanceWithDefault(preferredSubtitleOffset,subtitleOffsetForDate,CGPointInfinity);
     }
-    if (cell.numberOfEvents) {
-        MMCalendarInvalidateCellAppearance(preferredEventDefaultColors,eventDefaultColorsForDate);
+    if (missingParts & MMCalendarDayAppearancePartEvent) {
+        if (!_eventStore) {
+            MMCalendarInvalidateCellAppearance(preferredEventDefaultColors,eventDefaultColorsForDate);
+        }
         MMCalendarInvalidateCellAppearance(preferredEventSelectionColors,eventSelectionColorsForDate);
         MMCalendarInvalidateCellAppearanceWithDefault(preferredEventOffset,eventOffsetForDate,CGPointInfinity);
     }
-    MMCalendarInvalidateCellAppearance(preferredBorderDefaultColor,borderDefaultColorForDate);
-    MMCalendarInvalidateCellAppearance(preferredBorderSelectionColor,borderSelectionColorForDate);
-    MMCalendarInvalidateCellAppearanceWithDefault(preferredBorderRadius,borderRadiusForDate,-1);
-
-    if (cell.image) {
+    if (missingParts & MMCalendarDayAppearancePartImage) {
         MMCalendarInvalidateCellAppearanceWithDefault(preferredImageOffset,imageOffsetForDate,CGPointInfinity);
     }
     
 #undef MMCalendarInvalidateCellAppearance
 #undef MMCalendarInvalidateCellAppearanceWithDefault
     
+    dayAppearance.resolvedParts |= missingParts;
+    [dayAppearance applyParts:parts toCell:cell];
+    
+    // Not cached, the store tells when they change
+    if (_eventStore && cell.numberOfEvents) {
+        cell.preferredEventDefaultColors = [self eventColorsForDayNumber:dayNumber];
+    }
 }
+
+- (nullable NSArray<UIColor *> *)eventColorsForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    NSArray *colors = _eventStore.colors;
+    if (!colors.count) return nil;
+    uint32_t colorIndexes[3]; // As many as the event indicator shows
+    NSUInteger count = [_eventStore getColorIndexes:colorIndexes maximumCount:3 forDayNumber:dayNumber];
+    if (!count) return nil;
+    NSMutableArray<UIColor *> *eventColors = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [eventColors addObject:colors[colorIndexes[i] % colors.count]];
+    }
+    return eventColors;
+}
+
 -(NSString*)arabicToWestern:(NSString *)numericString {
     NSMutableString *s = [NSMutableString stringWithString:numericString];
     NSString *arabic = @"١٢٣٤٥٦٧٨٩٠";
@@ -1614,31 +1939,31 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)reloadDataForCell:(MMCalendarCell *)cell atIndexPath:(NSIndexPath *)indexPath
 {
     cell.calendar = self;
-    NSDate *date = [self.calculator dateForIndexPath:indexPath];
-    cell.image = [self.dataSourceProxy calendar:self imageForDate:date];
-    cell.numberOfEvents = [self.dataSourceProxy calendar:self numberOfEventsForDate:date];
-    cell.titleLabel.text = [self.dataSourceProxy calendar:self titleForDate:date] ?: @([self.gregorian component:NSCalendarUnitDay fromDate:date]).stringValue;
+    MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+    NSDate *date = [self.calculator dateForDayNumber:dayInfo.dayNumber];
+    MMCalendarDayContent *content = [self contentForDayNumber:dayInfo.dayNumber atIndexPath:indexPath];
+    // An event store answers for events on its own, the data source isn't asked
+    if (content) {
+        cell.image = content.image;
+        cell.numberOfEvents = _eventStore ? [_eventStore numberOfEventsForDayNumber:dayInfo.dayNumber] : content.numberOfEvents;
+        cell.titleLabel.text = content.title ?: @(dayInfo.dayOfMonth).stringValue;
+    } else {
+        cell.image = [self.dataSourceProxy calendar:self imageForDate:date];
+        cell.numberOfEvents = _eventStore ? [_eventStore numberOfEventsForDayNumber:dayInfo.dayNumber] : [self.dataSourceProxy calendar:self numberOfEventsForDate:date];
+        cell.titleLabel.text = [self.dataSourceProxy calendar:self titleForDate:date] ?: @(dayInfo.dayOfMonth).stringValue;
+    }
     if (!_isLanguageRTL){
     cell.titleLabel.text = [self westernToArabic:cell.titleLabel.text];
     }
-    cell.subtitle  = [self.dataSourceProxy calendar:self subtitleForDate:date];
-    cell.selected = [_selectedDates containsObject:date];
-    cell.dateIsToday = self.today?[self.gregorian isDate:date inSameDayAsDate:self.today]:NO;
-    cell.weekend = [self.gregorian isDateInWeekend:date];
-    cell.monthPosition = [self.calculator monthPositionForIndexPath:indexPath];
-    switch (self.transitionCoordinator.representingScope) {
-        case MMCalendarScopeMonth: {
-            cell.placeholder = (cell.monthPosition == MMCalendarMonthPositionPrevious || cell.monthPosition == MMCalendarMonthPositionNext) || ![self isDateInRange:date];
-            if (cell.placeholder) {
-                cell.selected &= _pagingEnabled;
-                cell.dateIsToday &= _pagingEnabled;
-            }
-            break;
-        }
-        case MMCalendarScopeWeek: {
-            cell.placeholder = ![self isDateInRange:date];
-            break;
-        }
+    cell.subtitle  = content ? content.subtitle : [self.dataSourceProxy calendar:self subtitleForDate:date];
+    cell.selected = [_selection containsDayNumber:dayInfo.dayNumber];
+    cell.dateIsToday = (dayInfo.flags & MMCalendarDayFlagToday) != 0;
+    cell.weekend = (dayInfo.flags & MMCalendarDayFlagWeekend) != 0;
+    cell.monthPosition = dayInfo.monthPosition;
+    cell.placeholder = (dayInfo.flags & MMCalendarDayFlagPlaceholder) != 0;
+    if (cell.placeholder && self.transitionCoordinator.representingScope == MMCalendarScopeMonth) {
+        cell.selected &= _pagingEnabled;
+        cell.dateIsToday &= _pagingEnabled;
     }
     // Synchronize selecion state to the collection view, otherwise delegate methods would not be triggered.
     if (cell.selected) {
@@ -1646,10 +1971,180 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     } else {
         [self.collectionView deselectItemAtIndexPath:indexPath animated:NO];
     }
-    [self invalidateAppearanceForCell:cell forDate:date];
+    [self invalidateAppearanceForCell:cell forDate:date dayNumber:dayInfo.dayNumber];
     [cell configureAppearance];
 }
 
+- (nullable MMCalendarDayContent *)contentForDayNumber:(MMCalendarDayNumber)dayNumber atIndexPath:(NSIndexPath *)indexPath
+{
+    BOOL fillsContents = [self.dataSourceProxy respondsToSelector:@selector(calendar:contentForDatesInRange:into:)];
+    if (!fillsContents && ![self.dataSourceProxy respondsToSelector:@selector(calendar:prefetchContentForDatesInRange:into:progress:completion:)]) {
+        return nil;
+    }
+    // Items run day by day from the first day of the page
+    MMCalendarDayNumber firstDayNumber = dayNumber - indexPath.item;
+    NSInteger count = self.transitionCoordinator.representingScope == MMCalendarScopeMonth ? MMCalendarMaximumNumberOfDaysInPage : 7;
+    NSInteger page = NSNotFound;
+    NSInteger coldest = 0;
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+        if (_contentCounts[i] == count && _contentFirstDayNumbers[i] == firstDayNumber) {
+            page = i;
+            break;
+        }
+        if (_contentLastAccesses[i] < _contentLastAccesses[coldest]) {
+            coldest = i;
+        }
+    }
+    if (page == NSNotFound) {
+        if (!fillsContents) {
+            // Not prefetched, or not yet. The per-date methods answer
+            return nil;
+        }
+        page = coldest;
+        NSArray<MMCalendarDayContent *> *contents = _contentPages[page];
+        if (contents.count < count) {
+            // Made once per page, a prefetched week page is too short for a month
+            NSMutableArray<MMCalendarDayContent *> *records = [NSMutableArray arrayWithCapacity:MMCalendarMaximumNumberOfDaysInPage];
+            for (NSInteger i = 0; i < MMCalendarMaximumNumberOfDaysInPage; i++) {
+                [records addObject:[[MMCalendarDayContent alloc] init]];
+            }
+            contents = records.copy;
+            _contentPages[page] = contents;
+        }
+        if (count < contents.count) {
+            contents = [contents subarrayWithRange:NSMakeRange(0, count)];
+        }
+        for (NSInteger i = 0; i < count; i++) {
+            [contents[i] prepareForDate:[self.calculator dateForDayNumber:firstDayNumber+i]];
+        }
+        NSDateInterval *range = [[NSDateInterval alloc] initWithStartDate:contents.firstObject.date endDate:[self.calculator dateForDayNumber:firstDayNumber+count]];
+        _contentFirstDayNumbers[page] = firstDayNumber;
+        _contentCounts[page] = count;
+        [self.dataSourceProxy calendar:self contentForDatesInRange:range into:contents];
+    }
+    _contentLastAccesses[page] = ++_contentAccessCount;
+    return _contentPages[page][indexPath.item];
+}
+
+- (void)invalidateContents
+{
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+        _contentCounts[i] = 0;
+    }
+    [self.prefetchProgresses.allValues makeObjectsPerformSelector:@selector(cancel)];
+    [self.prefetchProgresses removeAllObjects];
+}
+
+- (void)invalidateContentsInDayNumbers:(MMCalendarSelection *)dayNumbers
+{
+    BOOL (^intersects)(MMCalendarDayNumber, NSInteger) = ^BOOL(MMCalendarDayNumber firstDayNumber, NSInteger count) {
+        for (NSInteger i = 0; i < count; i++) {
+            if ([dayNumbers containsDayNumber:firstDayNumber+i]) return YES;
+        }
+        return NO;
+    };
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+        if (_contentCounts[i] && intersects(_contentFirstDayNumbers[i], _contentCounts[i])) {
+            _contentCounts[i] = 0;
+        }
+    }
+    // A prefetch started before the change would install stale records
+    [self.prefetchProgresses.allKeys enumerateObjectsUsingBlock:^(NSNumber *key, NSUInteger idx, BOOL *stop) {
+        if (!intersects(MMCalendarPrefetchKeyFirstDayNumber(key), MMCalendarPrefetchKeyCount(key))) return;
+        [self.prefetchProgresses[key] cancel];
+        [self.prefetchProgresses removeObjectForKey:key];
+    }];
+}
+
+- (void)prefetchContentForSections:(NSIndexSet *)sections cancellingOthers:(BOOL)cancellingOthers
+{
+    if (![self.dataSourceProxy respondsToSelector:@selector(calendar:prefetchContentForDatesInRange:into:progress:completion:)]) {
+        return;
+    }
+    MMCalendarScope scope = self.transitionCoordinator.representingScope;
+    NSInteger count = scope == MMCalendarScopeMonth ? MMCalendarMaximumNumberOfDaysInPage : 7;
+    NSMutableSet<NSNumber *> *keys = [NSMutableSet setWithCapacity:sections.count];
+    [sections enumerateIndexesUsingBlock:^(NSUInteger section, BOOL *stop) {
+        if (section >= self.calculator.numberOfSections) return;
+        MMCalendarDayNumber firstDayNumber = scope == MMCalendarScopeMonth ? [self.calculator monthHeadDayNumberForSection:section] : [self.calculator weekDayNumberForSection:section];
+        NSNumber *key = MMCalendarPrefetchKey(firstDayNumber, count);
+        [keys addObject:key];
+        if (self.prefetchProgresses[key]) return;
+        for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+            if (_contentCounts[i] == count && _contentFirstDayNumbers[i] == firstDayNumber) return;
+        }
+        
+        // Fresh records, the cached ones may be on screen while the data source fills these on its own queue
+        NSMutableArray<MMCalendarDayContent *> *contents = [NSMutableArray arrayWithCapacity:count];
+        for (NSInteger i = 0; i < count; i++) {
+            MMCalendarDayContent *content = [[MMCalendarDayContent alloc] init];
+            [content prepareForDate:[self.calculator dateForDayNumber:firstDayNumber+i]];
+            [contents addObject:content];
+        }
+        NSArray<MMCalendarDayContent *> *records = contents.copy;
+        NSDateInterval *range = [[NSDateInterval alloc] initWithStartDate:records.firstObject.date endDate:[self.calculator dateForDayNumber:firstDayNumber+count]];
+        NSProgress *progress = [NSProgress discreteProgressWithTotalUnitCount:count];
+        self.prefetchProgresses[key] = progress;
+        
+        __weak MMCalendar *weakSelf = self;
+        [self.dataSourceProxy calendar:self prefetchContentForDatesInRange:range into:records progress:progress completion:^{
+            dispatch_async(dispatch_get_main_queue(), ^{
+                MMCalendar *calendar = weakSelf;
+                // Cancelled, or superseded by a reload
+                if (!calendar || progress.cancelled || calendar.prefetchProgresses[key] != progress) return;
+                [calendar.prefetchProgresses removeObjectForKey:key];
+                [calendar installContents:records firstDayNumber:firstDayNumber];
+            });
+        }];
+    }];
+    if (cancellingOthers) {
+        [self.prefetchProgresses.allKeys enumerateObjectsUsingBlock:^(NSNumber *key, NSUInteger idx, BOOL *stop) {
+            if ([keys containsObject:key]) return;
+            [self.prefetchProgresses[key] cancel];
+            [self.prefetchProgresses removeObjectForKey:key];
+        }];
+    }
+}
+
+- (void)prefetchContentAroundCurrentPage
+{
+    if (!_currentPage || ![self.dataSourceProxy respondsToSelector:@selector(calendar:prefetchContentForDatesInRange:into:progress:completion:)]) {
+        return;
+    }
+    // The current page and the ones on either side, in whichever direction the calendar scrolls. Prefetches of pages left behind are cancelled
+    NSInteger section = [self.calculator indexPathForDate:_currentPage scope:self.transitionCoordinator.representingScope].section;
+    NSMutableIndexSet *sections = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(section, 2)];
+    if (section > 0) [sections addIndex:section-1];
+    [self prefetchContentForSections:sections cancellingOthers:YES];
+}
+
+- (void)installContents:(NSArray<MMCalendarDayContent *> *)contents firstDayNumber:(MMCalendarDayNumber)firstDayNumber
+{
+    NSInteger count = contents.count;
+    NSInteger page = 0;
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedContentPages; i++) {
+        if (_contentCounts[i] == count && _contentFirstDayNumbers[i] == firstDayNumber) {
+            // Filled in the meantime
+            return;
+        }
+        if (_contentLastAccesses[i] < _contentLastAccesses[page]) {
+            page = i;
+        }
+    }
+    _contentPages[page] = contents;
+    _contentFirstDayNumbers[page] = firstDayNumber;
+    _contentCounts[page] = count;
+    _contentLastAccesses[page] = ++_contentAccessCount;
+    // Cells of the page already on screen show the per-date answers until now
+    for (NSIndexPath *indexPath in self.collectionView.indexPathsForVisibleItems) {
+        MMCalendarCell *cell = (MMCalendarCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        if (![cell isKindOfClass:[MMCalendarCell class]]) continue;
+        MMCalendarDayNumber dayNumber = [self.calculator dayInfoForIndexPath:indexPath].dayNumber;
+        if (dayNumber - indexPath.item != firstDayNumber) continue;
+        [self reloadDataForCell:cell atIndexPath:indexPath];
+    }
+}
+
 
 - (void)handleSwipeToChoose:(UILongPressGestureRecognizer *)pressGesture
 {
@@ -1658,14 +2153,27 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         case UIGestureRecognizerStateChanged: {
             NSIndexPath *indexPath = [self.collectionView indexPathForItemAtPoint:[pressGesture locationInView:self.collectionView]];
             if (indexPath && ![indexPath isEqual:self.lastPressedIndexPath]) {
-                NSDate *date = [self.calculator dateForIndexPath:indexPath];
-                MMCalendarMonthPosition monthPosition = [self.calculator monthPositionForIndexPath:indexPath];
-                if (![self.selectedDates containsObject:date] && [self collectionView:self.collectionView shouldSelectItemAtIndexPath:indexPath]) {
-                    [self selectDate:date scrollToDate:NO atMonthPosition:monthPosition];
-                    [self collectionView:self.collectionView didSelectItemAtIndexPath:indexPath];
-                } else if (self.collectionView.allowsMultipleSelection && [self collectionView:self.collectionView shouldDeselectItemAtIndexPath:indexPath]) {
-                    [self deselectDate:date];
-                    [self collectionView:self.collectionView didDeselectItemAtIndexPath:indexPath];
+                if (self.allowsRangeSelection && self.allowsMultipleSelection) {
+                    MMCalendarDayNumber dayNumber = [self.calculator dayNumberForIndexPath:indexPath scope:self.transitionCoordinator.representingScope];
+                    if (pressGesture.state == UIGestureRecognizerStateBegan) {
+                        if (![self collectionView:self.collectionView shouldSelectItemAtIndexPath:indexPath]) break;
+                        self.rangeAnchorDayNumber = dayNumber;
+                        self.rangeSelection = [[MMCalendarSelection alloc] init];
+                        self.refusedRangeDayNumbers = [[MMCalendarSelection alloc] init];
+                    }
+                    if (self.rangeSelection) {
+                        [self extendRangeSelectionToDayNumber:dayNumber];
+                    }
+                } else {
+                    NSDate *date = [self.calculator dateForIndexPath:indexPath];
+                    MMCalendarMonthPosition monthPosition = [self.calculator monthPositionForIndexPath:indexPath];
+                    if (![_selection containsDayNumber:[self.calculator dayNumberForDate:date]] && [self collectionView:self.collectionView shouldSelectItemAtIndexPath:indexPath]) {
+                        [self selectDate:date scrollToDate:NO atMonthPosition:monthPosition];
+                        [self collectionView:self.collectionView didSelectItemAtIndexPath:indexPath];
+                    } else if (self.collectionView.allowsMultipleSelection && [self collectionView:self.collectionView shouldDeselectItemAtIndexPath:indexPath]) {
+                        [self deselectDate:date];
+                        [self collectionView:self.collectionView didDeselectItemAtIndexPath:indexPath];
+                    }
                 }
             }
             self.lastPressedIndexPath = indexPath;
@@ -1674,6 +2182,22 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         case UIGestureRecognizerStateEnded:
         case UIGestureRecognizerStateCancelled: {
             self.lastPressedIndexPath = nil;
+            if (self.rangeSelection.count) {
+                NSMutableArray<NSDate *> *dates = [NSMutableArray arrayWithCapacity:self.rangeSelection.count];
+                [self.rangeSelection enumerateDayNumbersUsingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+                    [dates addObject:[self.calculator dateForDayNumber:dayNumber]];
+                }];
+                if ([self.delegateProxy respondsToSelector:@selector(calendar:didSelectDates:)]) {
+                    [self.delegateProxy calendar:self didSelectDates:dates];
+                } else {
+                    // Delegates written before range selection still hear about every date
+                    for (NSDate *date in dates) {
+                        [self.delegateProxy calendar:self didSelectDate:date atMonthPosition:MMCalendarMonthPositionCurrent];
+                    }
+                }
+            }
+            self.rangeSelection = nil;
+            self.refusedRangeDayNumbers = nil;
             break;
         }
         default:
@@ -1682,6 +2206,97 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
    
 }
 
+- (BOOL)shouldSelectDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    if (dayNumber < self.calculator.minimumDayNumber || dayNumber > self.calculator.maximumDayNumber) {
+        return NO;
+    }
+    return ![self.delegateProxy respondsToSelector:@selector(calendar:shouldSelectDate:atMonthPosition:)] || [self.delegateProxy calendar:self shouldSelectDate:[self.calculator dateForDayNumber:dayNumber] atMonthPosition:MMCalendarMonthPositionCurrent];
+}
+
+- (void)extendRangeSelectionToDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    MMCalendarDayNumber anchor = self.rangeAnchorDayNumber;
+    MMCalendarDayNumber firstDayNumber = MIN(anchor, dayNumber);
+    MMCalendarDayNumber lastDayNumber = MAX(anchor, dayNumber);
+    
+    // Days added earlier in this gesture that the range no longer covers are given back
+    NSMutableArray<NSNumber *> *abandonedDayNumbers = [NSMutableArray array];
+    [self.rangeSelection enumerateDayNumbersUsingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+        if (dayNumber < firstDayNumber || dayNumber > lastDayNumber) {
+            [abandonedDayNumbers addObject:@(dayNumber)];
+        }
+    }];
+    for (NSNumber *abandonedDayNumber in abandonedDayNumbers) {
+        [self.rangeSelection removeDayNumber:abandonedDayNumber.integerValue];
+        [_selection removeDayNumber:abandonedDayNumber.integerValue];
+    }
+    // Days that can't be selected are skipped, the range goes on past them. Days selected or refused already are not asked again
+    for (MMCalendarDayNumber dayNumber = firstDayNumber; dayNumber <= lastDayNumber; dayNumber++) {
+        if ([_selection containsDayNumber:dayNumber] || [self.refusedRangeDayNumbers containsDayNumber:dayNumber]) {
+            continue;
+        }
+        if (![self shouldSelectDayNumber:dayNumber]) {
+            [self.refusedRangeDayNumbers addDayNumber:dayNumber];
+            continue;
+        }
+        [_selection addDayNumber:dayNumber];
+        [self.rangeSelection addDayNumber:dayNumber];
+    }
+    _selectedDates = nil;
+    [self reloadSelectionForVisibleCells];
+}
+
+- (void)reloadSelectionForVisibleCells
+{
+    if (self.numberOfBatchSelectionUpdates) return;
+    BOOL monthScope = self.transitionCoordinator.representingScope == MMCalendarScopeMonth;
+    for (NSIndexPath *indexPath in self.collectionView.indexPathsForVisibleItems) {
+        MMCalendarCell *cell = (MMCalendarCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+        BOOL selected = [_selection containsDayNumber:dayInfo.dayNumber];
+        if (monthScope && (dayInfo.flags & MMCalendarDayFlagPlaceholder)) {
+            selected &= _pagingEnabled;
+        }
+        if (cell.selected == selected) continue;
+        cell.selected = selected;
+        if (selected) {
+            [self.collectionView selectItemAtIndexPath:indexPath animated:NO scrollPosition:UICollectionViewScrollPositionNone];
+        } else {
+            [self.collectionView deselectItemAtIndexPath:indexPath animated:NO];
+        }
+        [cell configureAppearance];
+    }
+}
+
+- (void)reloadDayNumbers:(MMCalendarSelection *)dayNumbers
+{
+    [self invalidateContentsInDayNumbers:dayNumbers];
+    [dayNumbers enumerateDayNumbersUsingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+        [self.appearanceCache removeObjectForKey:@(dayNumber)];
+    }];
+    // Reconfigured in place, dequeuing new cells would rebuild their layers
+    for (NSIndexPath *indexPath in self.collectionView.indexPathsForVisibleItems) {
+        MMCalendarCell *cell = (MMCalendarCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        if (![cell isKindOfClass:[MMCalendarCell class]]) continue;
+        if (![dayNumbers containsDayNumber:[self.calculator dayInfoForIndexPath:indexPath].dayNumber]) continue;
+        [self reloadDataForCell:cell atIndexPath:indexPath];
+    }
+    [self prefetchContentAroundCurrentPage];
+}
+
+- (void)reloadAppearanceForVisibleCellsInDayNumbers:(nullable MMCalendarSelection *)dayNumbers
+{
+    for (NSIndexPath *indexPath in self.collectionView.indexPathsForVisibleItems) {
+        MMCalendarCell *cell = (MMCalendarCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        if (![cell isKindOfClass:[MMCalendarCell class]]) continue;
+        MMCalendarDayInfo dayInfo = [self.calculator dayInfoForIndexPath:indexPath];
+        if (dayNumbers && ![dayNumbers containsDayNumber:dayInfo.dayNumber]) continue;
+        [self invalidateAppearanceForCell:cell forDate:[self.calculator dateForDayNumber:dayInfo.dayNumber] dayNumber:dayInfo.dayNumber];
+        [cell configureAppearance];
+    }
+}
+
 - (void)selectCounterpartDate:(NSDate *)date
 {
     if (_placeholderType == MMCalendarPlaceholderTypeNone) return;
@@ -1725,11 +2340,10 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 - (void)enqueueSelectedDate:(NSDate *)date
 {
     if (!self.allowsMultipleSelection) {
-        [_selectedDates removeAllObjects];
-    }
-    if (![_selectedDates containsObject:date]) {
-        [_selectedDates addObject:date];
+        [_selection removeAllDayNumbers];
     }
+    [_selection addDayNumber:[self.calculator dayNumberForDate:date]];
+    _selectedDates = nil;
 }
 
 - (NSArray *)visibleStickyHeaders
@@ -1748,6 +2362,12 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
     [self.calendarHeaderView setNeedsAdjustingViewFrame:YES];
     [self setNeedsLayout];
     
+    if (self.floatingMode) {
+        // Paging rows follow the frame of the collection view, which the layout compares itself. A moving frame of the same size redoes nothing
+        MMCalendarCollectionViewLayoutInvalidationContext *context = [[MMCalendarCollectionViewLayoutInvalidationContext alloc] init];
+        context.invalidations = MMCalendarLayoutInvalidationRows;
+        [_collectionViewLayout invalidateLayoutWithContext:context];
+    }
 }
 
 // The best way to detect orientation
@@ -1788,7 +2408,10 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
         BOOL res = ![self.gregorian isDate:newMin inSameDayAsDate:_minimumDate] || ![self.gregorian isDate:newMax inSameDayAsDate:_maximumDate];
         _minimumDate = newMin;
         _maximumDate = newMax;
-        [self.calculator reloadSections];
+        if (res) {
+            // Other settings reload the sections themselves, possibly in the background
+            [self.calculator reloadSections];
+        }
         
         return res;
     }
@@ -1818,4 +2441,4 @@ typedef NS_ENUM(NSUInteger, MMCalendarOrientation) {
 
 @end
 
-
+#undef MMCalendarNumberOfCachedContentPages
@@ -11,6 +11,7 @@
 #import "MMCalendarAppearance.h"
 #import "MMCalendarDynamicHeader.h"
 #import "MMCalendarExtensions.h"
+#import "MMCalendarCollectionViewLayout.h"
 
 @interface MMCalendarAppearance ()
 
@@ -430,7 +431,9 @@
 {
     if (_separators != separators) {
         _separators = separators;
-        [_calendar.collectionView.collectionViewLayout invalidateLayout];
+        MMCalendarCollectionViewLayoutInvalidationContext *context = [[MMCalendarCollectionViewLayoutInvalidationContext alloc] init];
+        context.invalidations = MMCalendarLayoutInvalidationSeparators;
+        [_calendar.collectionView.collectionViewLayout invalidateLayoutWithContext:context];
     }
 }
 
@@ -8,6 +8,7 @@
 
 #import <UIKit/UIKit.h>
 #import <Foundation/Foundation.h>
+#import "MMCalendarSectionTable.h"
 
 struct MMCalendarCoordinate {
     NSInteger row;
@@ -15,12 +16,46 @@ struct MMCalendarCoordinate {
 };
 typedef struct MMCalendarCoordinate MMCalendarCoordinate;
 
+/**
+ * The sections, bounds and weekend rule of one set of calendar settings.
+ * Snapshots never change after init and can be used from any thread.
+ */
+@interface MMCalendarSnapshot : NSObject
+
+@property (readonly, nonatomic) MMCalendarSectionTable *table;
+@property (readonly, nonatomic) MMCalendarDateEngine *engine;
+@property (readonly, nonatomic) uint8_t weekendMask;
+@property (readonly, nonatomic) MMCalendarDayNumber todayDayNumber; // NSIntegerMin without today
+
+/**
+ * Builds the sections and warms the chunks around today and the current page.
+ */
+- (instancetype)initWithCalendar:(NSCalendar *)calendar minimumDate:(NSDate *)minimumDate maximumDate:(NSDate *)maximumDate today:(NSDate *)today currentPage:(NSDate *)currentPage;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)snapshotWithToday:(NSDate *)today;
+
+@end
+
 @interface MMCalendarCalculator : NSObject
 
 @property (weak  , nonatomic) MMCalendar *calendar;
 
 @property (readonly, nonatomic) NSInteger numberOfSections;
 
+/**
+ * The current snapshot. Safe to read from any thread, it is only swapped on the main thread.
+ */
+@property (readonly, atomic) MMCalendarSnapshot *snapshot;
+@property (readonly, nonatomic) MMCalendarDateEngine *engine;
+@property (readonly, nonatomic) MMCalendarDayNumber minimumDayNumber;
+@property (readonly, nonatomic) MMCalendarDayNumber maximumDayNumber;
+
+/**
+ * The maximum number of month chunks (32 sections each) kept in memory. Default is 12.
+ */
+@property (assign, nonatomic) NSUInteger chunkBudget;
+
 - (instancetype)initWithCalendar:(MMCalendar *)calendar;
 
 - (NSDate *)safeDateForDate:(NSDate *)date;
@@ -40,10 +75,45 @@ typedef struct MMCalendarCoordinate MMCalendarCoordinate;
 - (NSInteger)numberOfHeadPlaceholdersForMonth:(NSDate *)month;
 - (NSInteger)numberOfRowsInMonth:(NSDate *)month;
 - (NSInteger)numberOfRowsInSection:(NSInteger)section;
+- (NSInteger)numberOfRowsBeforeSection:(NSInteger)section;
+
+- (CGFloat)topForSection:(NSInteger)section headerHeight:(CGFloat)headerHeight rowHeight:(CGFloat)rowHeight;
+- (NSInteger)sectionAtOffset:(CGFloat)offset fromSection:(NSInteger)firstSection numberOfSections:(NSInteger)numberOfSections inclusive:(BOOL)inclusive headerHeight:(CGFloat)headerHeight rowHeight:(CGFloat)rowHeight;
 
 - (MMCalendarMonthPosition)monthPositionForIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ * Fills 42 day infos for a month section or 7 for a week section and returns the count.
+ */
+- (NSInteger)getDayInfos:(MMCalendarDayInfo *)dayInfos forSection:(NSInteger)section scope:(MMCalendarScope)scope;
+- (MMCalendarDayInfo)dayInfoForIndexPath:(NSIndexPath *)indexPath;
+- (MMCalendarDayInfo)dayInfoForIndexPath:(NSIndexPath *)indexPath scope:(MMCalendarScope)scope;
+- (void)invalidateDayInfos;
 - (MMCalendarCoordinate)coordinateForIndexPath:(NSIndexPath *)indexPath;
 
+- (MMCalendarDayNumber)dayNumberForDate:(NSDate *)date;
+- (NSDate *)dateForDayNumber:(MMCalendarDayNumber)dayNumber;
+- (MMCalendarDayNumber)dayNumberForIndexPath:(NSIndexPath *)indexPath scope:(MMCalendarScope)scope;
+- (MMCalendarDayNumber)monthDayNumberForSection:(NSInteger)section;
+- (MMCalendarDayNumber)monthHeadDayNumberForSection:(NSInteger)section;
+- (MMCalendarDayNumber)weekDayNumberForSection:(NSInteger)section;
+
 - (void)reloadSections;
 
+/**
+ * Builds the next snapshot on a background queue and swaps it in on the main queue, right before calling the completion.
+ * A snapshot requested later supersedes this one, the completion is called either way.
+ */
+- (void)reloadSectionsWithCompletion:(void (^)(void))completion;
+
+/**
+ * Makes the next reload build with a calendar the view doesn't use yet. The view switches to it in the swap block, called on the main queue in the same turn as the snapshot built with it is swapped in, so pages never mix the two.
+ * Swaps set before that are chained. A nil current page keeps the pending or current one.
+ */
+- (void)prepareCalendar:(NSCalendar *)calendar currentPage:(NSDate *)currentPage swap:(void (^)(void))swap;
+
+// The calendar the next snapshot is built with, nil when it is the one in use
+@property (readonly, nonatomic) NSCalendar *pendingCalendar;
+- (void)reloadToday;
+
 @end
@@ -11,20 +11,95 @@
 #import "MMCalendarDynamicHeader.h"
 #import "MMCalendarExtensions.h"
 
+#define MMCalendarNumberOfCachedPages 4
+
+typedef struct MMCalendarDayInfoPage {
+    NSInteger section;
+    MMCalendarScope scope;
+    MMCalendarDayNumber firstDayNumber;
+    NSUInteger lastAccess;
+    NSInteger count;
+    MMCalendarDayInfo dayInfos[MMCalendarMaximumNumberOfDaysInPage];
+} MMCalendarDayInfoPage;
+
+@interface MMCalendarSnapshot ()
+
+- (instancetype)initWithTable:(MMCalendarSectionTable *)table weekendMask:(uint8_t)weekendMask todayDayNumber:(MMCalendarDayNumber)todayDayNumber NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation MMCalendarSnapshot
+
+- (instancetype)initWithTable:(MMCalendarSectionTable *)table weekendMask:(uint8_t)weekendMask todayDayNumber:(MMCalendarDayNumber)todayDayNumber
+{
+    self = [super init];
+    if (self) {
+        _table = table;
+        _engine = table.engine;
+        _weekendMask = weekendMask;
+        _todayDayNumber = todayDayNumber;
+    }
+    return self;
+}
+
+- (instancetype)initWithCalendar:(NSCalendar *)calendar minimumDate:(NSDate *)minimumDate maximumDate:(NSDate *)maximumDate today:(NSDate *)today currentPage:(NSDate *)currentPage
+{
+    MMCalendarDateEngine *engine = [[MMCalendarDateEngine alloc] initWithCalendar:calendar minimumDate:minimumDate];
+    MMCalendarSectionTable *table = [[MMCalendarSectionTable alloc] initWithEngine:engine minimumDayNumber:[engine dayNumberForDate:minimumDate] maximumDayNumber:[engine dayNumberForDate:maximumDate]];
+    uint8_t weekendMask = ({
+        uint8_t weekendMask = 0;
+        for (MMCalendarDayNumber dayNumber = 0; dayNumber < 7; dayNumber++) {
+            if ([engine.calendar isDateInWeekend:[engine dateForDayNumber:dayNumber]]) {
+                weekendMask |= 1 << [engine weekdayForDayNumber:dayNumber];
+            }
+        }
+        weekendMask;
+    });
+    self = [self initWithTable:table weekendMask:weekendMask todayDayNumber:today ? [engine dayNumberForDate:today] : NSIntegerMin];
+    if (self) {
+        // Looking up a day materializes the chunk of its month, so the first pages shown do not pay for it
+        for (NSDate *date in @[today?:minimumDate, currentPage?:minimumDate]) {
+            [table getItem:NULL section:NULL forDayNumber:[engine dayNumberForDate:date] atMonthPosition:MMCalendarMonthPositionCurrent scope:MMCalendarScopeMonth options:0];
+        }
+    }
+    return self;
+}
+
+- (instancetype)snapshotWithToday:(NSDate *)today
+{
+    MMCalendarDayNumber todayDayNumber = today ? [self.engine dayNumberForDate:today] : NSIntegerMin;
+    if (todayDayNumber == self.todayDayNumber) {
+        return self;
+    }
+    return [[MMCalendarSnapshot alloc] initWithTable:self.table weekendMask:self.weekendMask todayDayNumber:todayDayNumber];
+}
+
+@end
+
 @interface MMCalendarCalculator ()
 
-@property (assign, nonatomic) NSInteger numberOfMonths;
-@property (strong, nonatomic) NSMutableDictionary<NSNumber *, NSDate *> *months;
-@property (strong, nonatomic) NSMutableDictionary<NSNumber *, NSDate *> *monthHeads;
+@property (strong, atomic) MMCalendarSnapshot *snapshot;
+@property (readonly, nonatomic) MMCalendarSectionTable *table;
+@property (readonly, nonatomic) MMCalendarSectionOptions sectionOptions;
+@property (assign, nonatomic) NSUInteger accessCount;
 
-@property (assign, nonatomic) NSInteger numberOfWeeks;
-@property (strong, nonatomic) NSMutableDictionary<NSNumber *, NSDate *> *weeks;
-@property (strong, nonatomic) NSMutableDictionary<NSDate *, NSNumber *> *rowCounts;
+// Snapshots are built here, a request supersedes the ones with a lower generation
+@property (strong, nonatomic) dispatch_queue_t queue;
+@property (assign, nonatomic) NSUInteger generation;
+@property (strong, nonatomic) NSCalendar *pendingCalendar;
+@property (strong, nonatomic) NSDate *pendingCurrentPage;
+@property (copy  , nonatomic) void (^pendingSwap)(void);
+
+// Day infos of the last few pages handed to cells
+@property (assign, nonatomic) MMCalendarDayInfoPage *pages;
 
 @property (readonly, nonatomic) NSCalendar *gregorian;
 @property (readonly, nonatomic) NSDate *minimumDate;
 @property (readonly, nonatomic) NSDate *maximumDate;
 
+- (void)swapSnapshot:(MMCalendarSnapshot *)snapshot;
+- (void)swapPendingCalendar;
+
 - (void)didReceiveNotifications:(NSNotification *)notification;
 
 @end
@@ -39,10 +114,12 @@
     if (self) {
         self.calendar = calendar;
         
-        self.months = [NSMutableDictionary dictionary];
-        self.monthHeads = [NSMutableDictionary dictionary];
-        self.weeks = [NSMutableDictionary dictionary];
-        self.rowCounts = [NSMutableDictionary dictionary];
+        _chunkBudget = 12;
+        
+        self.pages = calloc(MMCalendarNumberOfCachedPages, sizeof(MMCalendarDayInfoPage));
+        self.queue = dispatch_queue_create("MMCalendarCalculator", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        
+        [self reloadSections];
         
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveNotifications:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
     }
@@ -52,6 +129,8 @@
 - (void)dealloc
 {
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    
+    free(self.pages);
 }
 
 - (id)forwardingTargetForSelector:(SEL)selector
@@ -66,9 +145,10 @@
 
 - (NSDate *)safeDateForDate:(NSDate *)date
 {
-    if ([self.gregorian compareDate:date toDate:self.minimumDate toUnitGranularity:NSCalendarUnitDay] == NSOrderedAscending) {
+    MMCalendarDayNumber dayNumber = [self dayNumberForDate:date];
+    if (dayNumber < self.minimumDayNumber) {
         date = self.minimumDate;
-    } else if ([self.gregorian compareDate:date toDate:self.maximumDate toUnitGranularity:NSCalendarUnitDay] == NSOrderedDescending) {
+    } else if (dayNumber > self.maximumDayNumber) {
         date = self.maximumDate;
     }
     return date;
@@ -77,21 +157,7 @@
 - (NSDate *)dateForIndexPath:(NSIndexPath *)indexPath scope:(MMCalendarScope)scope
 {
     if (!indexPath) return nil;
-    switch (scope) {
-        case MMCalendarScopeMonth: {
-            NSDate *head = [self monthHeadForSection:indexPath.section];
-            NSUInteger daysOffset = indexPath.item;
-            NSDate *date = [self.gregorian dateByAddingUnit:NSCalendarUnitDay value:daysOffset toDate:head options:0];
-            return date;
-            break;
-        }
-        case MMCalendarScopeWeek: {
-            NSDate *currentPage = [self weekForSection:indexPath.section];
-            NSDate *date = [self.gregorian dateByAddingUnit:NSCalendarUnitDay value:indexPath.item toDate:currentPage options:0];
-            return date;
-        }
-    }
-    return nil;
+    return [self dateForDayNumber:[self dayNumberForIndexPath:indexPath scope:scope]];
 }
 
 - (NSDate *)dateForIndexPath:(NSIndexPath *)indexPath
@@ -112,28 +178,10 @@
 
 - (NSIndexPath *)indexPathForDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)position scope:(MMCalendarScope)scope
 {
-    if (!date) return nil;
+    if (!date || !self.table) return nil;
     NSInteger item = 0;
     NSInteger section = 0;
-    switch (scope) {
-        case MMCalendarScopeMonth: {
-            section = [self.gregorian components:NSCalendarUnitMonth fromDate:[self.gregorian fs_firstDayOfMonth:self.minimumDate] toDate:[self.gregorian fs_firstDayOfMonth:date] options:0].month;
-            if (position == MMCalendarMonthPositionPrevious) {
-                section++;
-            } else if (position == MMCalendarMonthPositionNext) {
-                section--;
-            }
-            NSDate *head = [self monthHeadForSection:section];
-            item = [self.gregorian components:NSCalendarUnitDay fromDate:head toDate:date options:0].day;
-            break;
-        }
-        case MMCalendarScopeWeek: {
-            section = [self.gregorian components:NSCalendarUnitWeekOfYear fromDate:[self.gregorian fs_firstDayOfWeek:self.minimumDate] toDate:[self.gregorian fs_firstDayOfWeek:date] options:0].weekOfYear;
-            item = (([self.gregorian component:NSCalendarUnitWeekday fromDate:date] - self.gregorian.firstWeekday) + 7) % 7;
-            break;
-        }
-    }
-    if (item < 0 || section < 0) {
+    if (![self.table getItem:&item section:&section forDayNumber:[self dayNumberForDate:date] atMonthPosition:position scope:scope options:self.sectionOptions]) {
         return nil;
     }
     NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
@@ -149,7 +197,7 @@
 {
     switch (self.calendar.transitionCoordinator.representingScope) {
         case MMCalendarScopeWeek:
-            return [self.gregorian fs_middleDayOfWeek:[self weekForSection:section]];
+            return [self dateForDayNumber:[self weekDayNumberForSection:section]+3];
         case MMCalendarScopeMonth:
             return [self monthForSection:section];
         default:
@@ -159,54 +207,30 @@
 
 - (NSDate *)monthForSection:(NSInteger)section
 {
-    NSNumber *key = @(section);
-    NSDate *month = self.months[key];
-    if (!month) {
-        month = [self.gregorian dateByAddingUnit:NSCalendarUnitMonth value:section toDate:[self.gregorian fs_firstDayOfMonth:self.minimumDate] options:0];
-        NSInteger numberOfHeadPlaceholders = [self numberOfHeadPlaceholdersForMonth:month];
-        NSDate *monthHead = [self.gregorian dateByAddingUnit:NSCalendarUnitDay value:-numberOfHeadPlaceholders toDate:month options:0];
-        self.months[key] = month;
-        self.monthHeads[key] = monthHead;
-    }
-    return month;
+    return [self dateForDayNumber:[self monthDayNumberForSection:section]];
 }
 
 - (NSDate *)monthHeadForSection:(NSInteger)section
 {
-    NSNumber *key = @(section);
-    NSDate *monthHead = self.monthHeads[key];
-    if (!monthHead) {
-        NSDate *month = [self.gregorian dateByAddingUnit:NSCalendarUnitMonth value:section toDate:[self.gregorian fs_firstDayOfMonth:self.minimumDate] options:0];
-        NSInteger numberOfHeadPlaceholders = [self numberOfHeadPlaceholdersForMonth:month];
-        monthHead = [self.gregorian dateByAddingUnit:NSCalendarUnitDay value:-numberOfHeadPlaceholders toDate:month options:0];
-        self.months[key] = month;
-        self.monthHeads[key] = monthHead;
-    }
-    return monthHead;
+    return [self dateForDayNumber:[self monthHeadDayNumberForSection:section]];
 }
 
 - (NSDate *)weekForSection:(NSInteger)section
 {
-    NSNumber *key = @(section);
-    NSDate *week = self.weeks[key];
-    if (!week) {
-        week = [self.gregorian dateByAddingUnit:NSCalendarUnitWeekOfYear value:section toDate:[self.gregorian fs_firstDayOfWeek:self.minimumDate] options:0];
-        self.weeks[key] = week;
-    }
-    return week;
+    return [self dateForDayNumber:[self weekDayNumberForSection:section]];
 }
 
 - (NSInteger)numberOfSections
 {
     if (self.calendar.transitionCoordinator.transition == MMCalendarTransitionWeekToMonth) {
-        return self.numberOfMonths;
+        return self.table.numberOfMonths;
     } else {
         switch (self.calendar.transitionCoordinator.representingScope) {
             case MMCalendarScopeMonth: {
-                return self.numberOfMonths;
+                return self.table.numberOfMonths;
             }
             case MMCalendarScopeWeek: {
-                return self.numberOfWeeks;
+                return self.table.numberOfWeeks;
             }
         }
     }
@@ -214,53 +238,88 @@
 
 - (NSInteger)numberOfHeadPlaceholdersForMonth:(NSDate *)month
 {
-    NSInteger currentWeekday = [self.gregorian component:NSCalendarUnitWeekday fromDate:month];
-    NSInteger number = ((currentWeekday- self.gregorian.firstWeekday) + 7) % 7 ?: (7 * (!self.calendar.floatingMode&&(self.calendar.placeholderType == MMCalendarPlaceholderTypeFillSixRows)));
-    return number;
+    return [self.table numberOfHeadPlaceholdersForDayNumber:[self dayNumberForDate:month] options:self.sectionOptions];
 }
 
 - (NSInteger)numberOfRowsInMonth:(NSDate *)month
 {
     if (!month) return 0;
-    if (self.calendar.placeholderType == MMCalendarPlaceholderTypeFillSixRows) return 6;
-    
-    NSNumber *rowCount = self.rowCounts[month];
-    if (!rowCount) {
-        NSDate *firstDayOfMonth = [self.gregorian fs_firstDayOfMonth:month];
-        NSInteger weekdayOfFirstDay = [self.gregorian component:NSCalendarUnitWeekday fromDate:firstDayOfMonth];
-        NSInteger numberOfDaysInMonth = [self.gregorian fs_numberOfDaysInMonth:month];
-        NSInteger numberOfPlaceholdersForPrev = ((weekdayOfFirstDay - self.gregorian.firstWeekday) + 7) % 7;
-        NSInteger headDayCount = numberOfDaysInMonth + numberOfPlaceholdersForPrev;
-        NSInteger numberOfRows = (headDayCount/7) + (headDayCount%7>0);
-        rowCount = @(numberOfRows);
-        self.rowCounts[month] = rowCount;
-    }
-    return rowCount.integerValue;
+    return [self.table numberOfRowsInMonthOfDayNumber:[self dayNumberForDate:month] options:self.sectionOptions];
 }
 
 - (NSInteger)numberOfRowsInSection:(NSInteger)section
 {
-    if (self.calendar.transitionCoordinator.representingScope == MMCalendarScopeWeek) return 1;
-    NSDate *month = [self monthForSection:section];
-    return [self numberOfRowsInMonth:month];
+    return [self.table numberOfRowsInSection:section scope:self.calendar.transitionCoordinator.representingScope options:self.sectionOptions];
+}
+
+- (NSInteger)numberOfRowsBeforeSection:(NSInteger)section
+{
+    return [self.table numberOfRowsBeforeSection:section scope:self.calendar.transitionCoordinator.representingScope options:self.sectionOptions];
+}
+
+- (CGFloat)topForSection:(NSInteger)section headerHeight:(CGFloat)headerHeight rowHeight:(CGFloat)rowHeight
+{
+    return [self.table topForSection:section headerHeight:headerHeight rowHeight:rowHeight scope:self.calendar.transitionCoordinator.representingScope options:self.sectionOptions];
+}
+
+- (NSInteger)sectionAtOffset:(CGFloat)offset fromSection:(NSInteger)firstSection numberOfSections:(NSInteger)numberOfSections inclusive:(BOOL)inclusive headerHeight:(CGFloat)headerHeight rowHeight:(CGFloat)rowHeight
+{
+    return [self.table sectionAtOffset:offset fromSection:firstSection numberOfSections:numberOfSections inclusive:inclusive headerHeight:headerHeight rowHeight:rowHeight scope:self.calendar.transitionCoordinator.representingScope options:self.sectionOptions];
 }
 
 - (MMCalendarMonthPosition)monthPositionForIndexPath:(NSIndexPath *)indexPath
 {
     if (!indexPath) return MMCalendarMonthPositionNotFound;
-    if (self.calendar.transitionCoordinator.representingScope == MMCalendarScopeWeek) {
-        return MMCalendarMonthPositionCurrent;
+    return [self.table monthPositionForItem:indexPath.item section:indexPath.section scope:self.calendar.transitionCoordinator.representingScope options:self.sectionOptions];
+}
+
+- (NSInteger)getDayInfos:(MMCalendarDayInfo *)dayInfos forSection:(NSInteger)section scope:(MMCalendarScope)scope
+{
+    MMCalendarSnapshot *snapshot = _snapshot;
+    if (!snapshot) return 0;
+    return [snapshot.table getDayInfos:dayInfos forSection:section scope:scope options:self.sectionOptions today:snapshot.todayDayNumber weekendMask:snapshot.weekendMask];
+}
+
+- (MMCalendarDayInfo)dayInfoForIndexPath:(NSIndexPath *)indexPath
+{
+    return [self dayInfoForIndexPath:indexPath scope:self.calendar.transitionCoordinator.representingScope];
+}
+
+- (MMCalendarDayInfo)dayInfoForIndexPath:(NSIndexPath *)indexPath scope:(MMCalendarScope)scope
+{
+    NSInteger section = indexPath.section;
+    MMCalendarDayNumber firstDay = scope == MMCalendarScopeMonth ? [self monthHeadDayNumberForSection:section] : [self weekDayNumberForSection:section];
+    MMCalendarDayInfoPage *page = NULL;
+    MMCalendarDayInfoPage *coldest = self.pages;
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedPages; i++) {
+        MMCalendarDayInfoPage *candidate = self.pages + i;
+        // The first day changes with the placeholder type and scroll mode, which makes it part of the key
+        if (candidate->count && candidate->section == section && candidate->scope == scope && candidate->firstDayNumber == firstDay) {
+            page = candidate;
+            break;
+        }
+        if (candidate->lastAccess < coldest->lastAccess) {
+            coldest = candidate;
+        }
+    }
+    if (!page) {
+        page = coldest;
+        page->section = section;
+        page->scope = scope;
+        page->firstDayNumber = firstDay;
+        page->count = [self getDayInfos:page->dayInfos forSection:section scope:scope];
     }
-    NSDate *date = [self dateForIndexPath:indexPath];
-    NSDate *page = [self pageForSection:indexPath.section];
-    NSComparisonResult comparison = [self.gregorian compareDate:date toDate:page toUnitGranularity:NSCalendarUnitMonth];
-    switch (comparison) {
-        case NSOrderedAscending:
-            return MMCalendarMonthPositionPrevious;
-        case NSOrderedSame:
-            return MMCalendarMonthPositionCurrent;
-        case NSOrderedDescending:
-            return MMCalendarMonthPositionNext;
+    page->lastAccess = ++_accessCount;
+    if (indexPath.item < page->count) {
+        return page->dayInfos[indexPath.item];
+    }
+    return (MMCalendarDayInfo){firstDay + indexPath.item, 0, MMCalendarMonthPositionNotFound, MMCalendarDayFlagPlaceholder};
+}
+
+- (void)invalidateDayInfos
+{
+    for (NSInteger i = 0; i < MMCalendarNumberOfCachedPages; i++) {
+        self.pages[i].count = 0;
     }
 }
 
@@ -272,28 +331,157 @@
     return coordinate;
 }
 
+- (MMCalendarDayNumber)dayNumberForDate:(NSDate *)date
+{
+    return [self.engine dayNumberForDate:date];
+}
+
+- (NSDate *)dateForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    return [self.engine dateForDayNumber:dayNumber];
+}
+
+- (MMCalendarDayNumber)dayNumberForIndexPath:(NSIndexPath *)indexPath scope:(MMCalendarScope)scope
+{
+    return [self.table dayNumberForItem:indexPath.item section:indexPath.section scope:scope options:self.sectionOptions];
+}
+
+- (MMCalendarDayNumber)monthDayNumberForSection:(NSInteger)section
+{
+    return [self.table monthDayNumberForSection:section];
+}
+
+- (MMCalendarDayNumber)monthHeadDayNumberForSection:(NSInteger)section
+{
+    return [self.table monthHeadDayNumberForSection:section options:self.sectionOptions];
+}
+
+- (MMCalendarDayNumber)weekDayNumberForSection:(NSInteger)section
+{
+    return [self.table weekDayNumberForSection:section];
+}
+
 - (void)reloadSections
 {
-    self.numberOfMonths = [self.gregorian components:NSCalendarUnitMonth fromDate:[self.gregorian fs_firstDayOfMonth:self.minimumDate] toDate:self.maximumDate options:0].month+1;
-    self.numberOfWeeks = [self.gregorian components:NSCalendarUnitWeekOfYear fromDate:[self.gregorian fs_firstDayOfWeek:self.minimumDate] toDate:self.maximumDate options:0].weekOfYear+1;
-    [self clearCaches];
+    [self swapPendingCalendar];
+    if (!self.minimumDate || !self.maximumDate) return;
+    self.generation++;
+    [self swapSnapshot:[[MMCalendarSnapshot alloc] initWithCalendar:self.gregorian minimumDate:self.minimumDate maximumDate:self.maximumDate today:self.calendar.today currentPage:self.calendar.currentPage]];
+}
+
+- (void)reloadSectionsWithCompletion:(void (^)(void))completion
+{
+    if (!self.minimumDate || !self.maximumDate) {
+        [self swapPendingCalendar];
+        if (completion) completion();
+        return;
+    }
+    // Everything the background queue needs is captured here, it never touches the calendar view
+    NSUInteger generation = ++self.generation;
+    NSCalendar *calendar = (self.pendingCalendar ?: self.gregorian).copy;
+    NSDate *minimumDate = self.minimumDate;
+    NSDate *maximumDate = self.maximumDate;
+    NSDate *today = self.calendar.today;
+    NSDate *currentPage = self.pendingCurrentPage ?: self.calendar.currentPage;
+    __weak MMCalendarCalculator *weakSelf = self;
+    dispatch_async(self.queue, ^{
+        MMCalendarSnapshot *snapshot = [[MMCalendarSnapshot alloc] initWithCalendar:calendar minimumDate:minimumDate maximumDate:maximumDate today:today currentPage:currentPage];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            MMCalendarCalculator *calculator = weakSelf;
+            if (calculator.generation == generation) {
+                // No later request, so the pending calendar is the one this snapshot was built with. Today may have been set while it was built
+                [calculator swapPendingCalendar];
+                [calculator swapSnapshot:[snapshot snapshotWithToday:calculator.calendar.today]];
+            }
+            if (completion) completion();
+        });
+    });
+}
+
+- (void)prepareCalendar:(NSCalendar *)calendar currentPage:(NSDate *)currentPage swap:(void (^)(void))swap
+{
+    void (^previousSwap)(void) = self.pendingSwap;
+    self.pendingSwap = previousSwap ? ^{
+        previousSwap();
+        swap();
+    } : swap;
+    self.pendingCalendar = calendar;
+    if (currentPage) {
+        self.pendingCurrentPage = currentPage;
+    }
+}
+
+- (void)reloadToday
+{
+    if (!self.snapshot) return;
+    [self swapSnapshot:[self.snapshot snapshotWithToday:self.calendar.today]];
+}
+
+- (void)setChunkBudget:(NSUInteger)chunkBudget
+{
+    _chunkBudget = MAX(chunkBudget, 1);
+    self.table.chunkBudget = _chunkBudget;
+}
+
+- (MMCalendarSectionTable *)table
+{
+    return _snapshot.table;
+}
+
+- (MMCalendarDateEngine *)engine
+{
+    return _snapshot.engine;
+}
+
+- (MMCalendarDayNumber)minimumDayNumber
+{
+    return self.table.minimumDayNumber;
 }
 
-- (void)clearCaches
+- (MMCalendarDayNumber)maximumDayNumber
 {
-    [self.months removeAllObjects];
-    [self.monthHeads removeAllObjects];
-    [self.weeks removeAllObjects];
-    [self.rowCounts removeAllObjects];
+    return self.table.maximumDayNumber;
+}
+
+- (MMCalendarSectionOptions)sectionOptions
+{
+    MMCalendarSectionOptions options = 0;
+    if (self.calendar.placeholderType == MMCalendarPlaceholderTypeFillSixRows) {
+        options |= MMCalendarSectionOptionSixRows;
+        if (!self.calendar.floatingMode) {
+            options |= MMCalendarSectionOptionLeadingRow;
+        }
+    }
+    return options;
 }
 
 #pragma mark - Private functinos
 
+- (void)swapPendingCalendar
+{
+    void (^swap)(void) = self.pendingSwap;
+    self.pendingSwap = nil;
+    self.pendingCalendar = nil;
+    self.pendingCurrentPage = nil;
+    if (swap) swap();
+}
+
+- (void)swapSnapshot:(MMCalendarSnapshot *)snapshot
+{
+    if (snapshot == self.snapshot) return;
+    snapshot.table.chunkBudget = self.chunkBudget;
+    self.snapshot = snapshot;
+    [self invalidateDayInfos];
+}
+
 - (void)didReceiveNotifications:(NSNotification *)notification
 {
     if ([notification.name isEqualToString:UIApplicationDidReceiveMemoryWarningNotification]) {
-        [self clearCaches];
+        // Keep the chunk around the visible page, the others are rebuilt on demand
+        [self.table trimChunksToCount:1];
     }
 }
 
 @end
+
+#undef MMCalendarNumberOfCachedPages
@@ -10,6 +10,24 @@
 
 @class MMCalendar;
 
+typedef NS_OPTIONS(NSUInteger, MMCalendarLayoutInvalidations) {
+    MMCalendarLayoutInvalidationColumns    = 1 << 0, // Widths and lefts, from the width of the collection view
+    MMCalendarLayoutInvalidationRows       = 1 << 1, // Heights and tops, from the height, the scope and the preferred heights
+    MMCalendarLayoutInvalidationSections   = 1 << 2, // The number of sections and of rows in each
+    MMCalendarLayoutInvalidationSeparators = 1 << 3,
+    MMCalendarLayoutInvalidationAll        = 0xF
+};
+
+/**
+ * Tells the layout which part of its geometry is stale, the rest is kept by -prepareLayout.
+ * Changes of size, section count, scope or separators are picked up on their own, so a plain -invalidateLayout still works.
+ */
+@interface MMCalendarCollectionViewLayoutInvalidationContext : UICollectionViewLayoutInvalidationContext
+
+@property (assign, nonatomic) MMCalendarLayoutInvalidations invalidations;
+
+@end
+
 @interface MMCalendarCollectionViewLayout : UICollectionViewLayout
 
 @property (weak, nonatomic) MMCalendar *calendar;
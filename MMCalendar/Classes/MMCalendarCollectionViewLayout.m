@@ -16,36 +16,147 @@
 #define kMMCalendarSeparatorInterRows @"MMCalendarSeparatorInterRows"
 #define kMMCalendarSeparatorInterColumns @"MMCalendarSeparatorInterColumns"
 
+// Pooled besides the sections the collection view can show at once, for the ones UIKit asks for around them
+#define MMCalendarNumberOfExtraPooledSections 6
+
+// Sections whose attributes are kept, least recently used first out
+typedef struct {
+    NSInteger capacity;
+    NSInteger *sections;
+    NSUInteger *lastAccesses;
+    NSUInteger accessCount;
+    NSInteger lastSlot;
+} MMCalendarSectionPool;
+
+static void MMCalendarSectionPoolReset(MMCalendarSectionPool *pool, NSInteger capacity)
+{
+    if (pool->capacity != capacity) {
+        free(pool->sections);
+        free(pool->lastAccesses);
+        pool->sections = malloc(sizeof(NSInteger)*capacity);
+        pool->lastAccesses = malloc(sizeof(NSUInteger)*capacity);
+        pool->capacity = capacity;
+    }
+    for (NSInteger i = 0; i < capacity; i++) {
+        pool->sections[i] = NSNotFound;
+        pool->lastAccesses[i] = 0;
+    }
+    pool->accessCount = 0;
+    pool->lastSlot = 0;
+}
+
+static void MMCalendarSectionPoolFree(MMCalendarSectionPool *pool)
+{
+    free(pool->sections);
+    free(pool->lastAccesses);
+    *pool = (MMCalendarSectionPool){0};
+}
+
+// Everything the layout computed for one scope, kept while the other scope shows
+@interface MMCalendarLayoutScopeState : NSObject
+
+@property (assign, nonatomic) MMCalendarScope scope;
+@property (assign, nonatomic) CGSize collectionViewSize;
+@property (assign, nonatomic) NSInteger numberOfSections;
+@property (assign, nonatomic) UICollectionViewScrollDirection scrollDirection;
+@property (assign, nonatomic) MMCalendarSeparators separators;
+
+@property (assign, nonatomic) CGFloat *heights;
+@property (assign, nonatomic) CGFloat *tops;
+@property (assign, nonatomic) CGFloat estimatedItemHeight;
+@property (assign, nonatomic) CGSize contentSize;
+
+@property (strong, nonatomic) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *itemAttributes;
+@property (strong, nonatomic) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *rowSeparatorAttributes;
+@property (assign, nonatomic) MMCalendarSectionPool pool;
+
+@end
+
 @interface MMCalendarCollectionViewLayout ()
+{
+    MMCalendarSectionPool _pool;
+    
+    // Parts asked to be redone by invalidation contexts since the last -prepareLayout
+    MMCalendarLayoutInvalidations _pendingInvalidations;
+}
 
 @property (assign, nonatomic) CGFloat *widths;
 @property (assign, nonatomic) CGFloat *heights;
 @property (assign, nonatomic) CGFloat *lefts;
 @property (assign, nonatomic) CGFloat *tops;
 
-@property (assign, nonatomic) CGFloat *sectionHeights;
-@property (assign, nonatomic) CGFloat *sectionTops;
-@property (assign, nonatomic) CGFloat *sectionBottoms;
-@property (assign, nonatomic) CGFloat *sectionRowCounts;
-
 @property (assign, nonatomic) CGSize estimatedItemSize;
 
 @property (assign, nonatomic) CGSize contentSize;
 @property (assign, nonatomic) CGSize collectionViewSize;
 @property (assign, nonatomic) NSInteger numberOfSections;
+@property (assign, nonatomic) MMCalendarScope representingScope;
+
+// What rows in a section follow from, besides the scope. Reloading data with them unchanged keeps every attribute
+@property (weak  , nonatomic) MMCalendarSectionTable *sectionTable;
+@property (assign, nonatomic) MMCalendarPlaceholderType placeholderType;
+@property (assign, nonatomic) BOOL floatingMode;
 
 @property (assign, nonatomic) MMCalendarSeparators separators;
 
 @property (strong, nonatomic) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *itemAttributes;
 @property (strong, nonatomic) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *headerAttributes;
+// Keyed by [row, section], one separator below every row but the last of a section
 @property (strong, nonatomic) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *rowSeparatorAttributes;
 
+// In paging mode, the attributes of the columns (horizontal) or rows (vertical) last asked for, one array per line
+@property (strong, nonatomic) NSMutableArray<NSArray<UICollectionViewLayoutAttributes *> *> *spanLines;
+@property (assign, nonatomic) NSInteger spanFirstLine;
+@property (assign, nonatomic) MMCalendarScope spanScope;
+@property (strong, nonatomic) NSMutableArray<UICollectionViewLayoutAttributes *> *spanBuffer;
+@property (strong, nonatomic) NSArray<UICollectionViewLayoutAttributes *> *spanAttributes;
+
+// The scope not showing, swapped back in when its scope returns with the same size, sections and separators
+@property (strong, nonatomic) MMCalendarLayoutScopeState *savedScopeState;
+
 - (void)didReceiveNotifications:(NSNotification *)notification;
 
+- (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForLinesFromLine:(NSInteger)firstLine toLine:(NSInteger)lastLine;
+- (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForLine:(NSInteger)line;
+
+- (void)poolSection:(NSInteger)section;
+- (void)removeAllPooledAttributes;
+- (NSInteger)numberOfPooledSections;
+
+- (MMCalendarLayoutScopeState *)takeScopeState;
+- (BOOL)restoreScopeState:(MMCalendarLayoutScopeState *)state;
+
+- (CGFloat)topForSection:(NSInteger)section;
+- (CGFloat)bottomForSection:(NSInteger)section;
+- (NSInteger)sectionAtOffset:(CGFloat)offset fromSection:(NSInteger)firstSection inclusive:(BOOL)inclusive;
+
+@end
+
+@implementation MMCalendarCollectionViewLayoutInvalidationContext
+
 @end
 
+
+@implementation MMCalendarLayoutScopeState
+
+- (void)dealloc
+{
+    free(self.heights);
+    free(self.tops);
+    MMCalendarSectionPool pool = self.pool;
+    MMCalendarSectionPoolFree(&pool);
+}
+
+@end
+
+
 @implementation MMCalendarCollectionViewLayout
 
++ (Class)invalidationContextClass
+{
+    return [MMCalendarCollectionViewLayoutInvalidationContext class];
+}
+
 - (instancetype)init
 {
     self = [super init];
@@ -56,17 +167,15 @@
         self.tops = NULL;
         self.lefts = NULL;
         
-        self.sectionHeights = NULL;
-        self.sectionTops = NULL;
-        self.sectionBottoms = NULL;
-        self.sectionRowCounts = NULL;
-        
         self.scrollDirection = UICollectionViewScrollDirectionHorizontal;
         self.sectionInsets = UIEdgeInsetsMake(1, 0, 1, 0);
         
         self.itemAttributes = [NSMutableDictionary dictionary];
         self.headerAttributes = [NSMutableDictionary dictionary];
         self.rowSeparatorAttributes = [NSMutableDictionary dictionary];
+        self.spanLines = [NSMutableArray array];
+        self.spanBuffer = [NSMutableArray array];
+        [self removeAllPooledAttributes];
         
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveNotifications:) name:UIDeviceOrientationDidChangeNotification object:nil];
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveNotifications:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
@@ -85,39 +194,130 @@
     free(self.heights);
     free(self.tops);
     free(self.lefts);
-    
-    free(self.sectionHeights);
-    free(self.sectionTops);
-    free(self.sectionRowCounts);
-    free(self.sectionBottoms);
+    MMCalendarSectionPoolFree(&_pool);
+}
+
+- (void)invalidateLayoutWithContext:(UICollectionViewLayoutInvalidationContext *)context
+{
+    [super invalidateLayoutWithContext:context];
+    if ([context isKindOfClass:[MMCalendarCollectionViewLayoutInvalidationContext class]]) {
+        _pendingInvalidations |= ((MMCalendarCollectionViewLayoutInvalidationContext *)context).invalidations;
+    }
 }
 
 - (void)prepareLayout
 {
-    if (CGSizeEqualToSize(self.collectionViewSize, self.collectionView.frame.size) && self.numberOfSections == self.collectionView.numberOfSections && self.separators == self.calendar.appearance.separators) {
+    MMCalendarLayoutInvalidations invalidations = _pendingInvalidations;
+    _pendingInvalidations = 0;
+    
+    // Reloading data only changes rows in a section with the sections themselves, for other dates or placeholders
+    MMCalendarSectionTable *sectionTable = self.calendar.calculator.snapshot.table;
+    if (sectionTable != self.sectionTable || self.placeholderType != self.calendar.placeholderType || self.floatingMode != self.calendar.floatingMode) {
+        self.sectionTable = sectionTable;
+        self.placeholderType = self.calendar.placeholderType;
+        self.floatingMode = self.calendar.floatingMode;
+        invalidations |= MMCalendarLayoutInvalidationSections;
+    }
+    if (invalidations & MMCalendarLayoutInvalidationSections) {
+        self.savedScopeState = nil;
+    }
+    
+    BOOL restored = NO;
+    MMCalendarScope representingScope = self.calendar.transitionCoordinator.representingScope;
+    if (representingScope != self.representingScope && !self.calendar.floatingMode && self.heights) {
+        // A scope switch reloads data for the other scope, the one before is kept for switching back
+        MMCalendarLayoutScopeState *savedScopeState = self.savedScopeState;
+        self.savedScopeState = [self takeScopeState];
+        restored = [self restoreScopeState:savedScopeState];
+        if (!restored) {
+            invalidations |= MMCalendarLayoutInvalidationRows|MMCalendarLayoutInvalidationSections;
+        }
+    }
+    
+    if (self.collectionViewSize.width != self.collectionView.fs_width) {
+        invalidations |= MMCalendarLayoutInvalidationColumns;
+    }
+    if (self.collectionViewSize.height != self.collectionView.fs_height || self.representingScope != representingScope) {
+        invalidations |= MMCalendarLayoutInvalidationRows;
+    }
+    BOOL numberOfSectionsChanged = self.numberOfSections != self.collectionView.numberOfSections;
+    if (numberOfSectionsChanged) {
+        invalidations |= MMCalendarLayoutInvalidationSections;
+    }
+    if (self.separators != self.calendar.appearance.separators) {
+        invalidations |= MMCalendarLayoutInvalidationSeparators;
+    }
+    if (!invalidations) {
+        if (restored) {
+            [self.calendar adjustMonthPosition];
+        }
         return;
     }
+    // What was asked for besides the scope switch is redone on top of a restored state
     self.collectionViewSize = self.collectionView.frame.size;
+    self.representingScope = representingScope;
     self.separators = self.calendar.appearance.separators;
     
-    [self.itemAttributes removeAllObjects];
-    [self.headerAttributes removeAllObjects];
-    [self.rowSeparatorAttributes removeAllObjects];
-    
-    self.headerReferenceSize = ({
-        CGSize headerSize = CGSizeZero;
-        if (self.calendar.floatingMode) {
-            CGFloat headerHeight = self.calendar.preferredWeekdayHeight*1.5+self.calendar.preferredHeaderHeight;
-            headerSize = CGSizeMake(self.collectionView.fs_width, headerHeight);
+    BOOL geometryChanged = (invalidations & (MMCalendarLayoutInvalidationColumns|MMCalendarLayoutInvalidationRows)) != 0;
+    if (geometryChanged || (invalidations & MMCalendarLayoutInvalidationSections)) {
+        [self removeAllPooledAttributes];
+    } else {
+        // Only separators, every item and header frame still holds
+        [self.rowSeparatorAttributes removeAllObjects];
+        [self.spanLines removeAllObjects];
+        self.spanAttributes = nil;
+        if (restored) {
+            [self.calendar adjustMonthPosition];
         }
-        headerSize;
-    });
-    self.estimatedItemSize = ({
+        return;
+    }
+    
+    if (geometryChanged) {
+        self.headerReferenceSize = ({
+            CGSize headerSize = CGSizeZero;
+            if (self.calendar.floatingMode) {
+                CGFloat headerHeight = self.calendar.preferredWeekdayHeight*1.5+self.calendar.preferredHeaderHeight;
+                headerSize = CGSizeMake(self.collectionView.fs_width, headerHeight);
+            }
+            headerSize;
+        });
+    }
+    
+    if (invalidations & MMCalendarLayoutInvalidationColumns) {
+        
         CGFloat width = (self.collectionView.fs_width-self.sectionInsets.left-self.sectionInsets.right)/7.0;
+        self.estimatedItemSize = CGSizeMake(width, self.estimatedItemSize.height);
+        
+        // Calculate item widths and lefts
+        free(self.widths);
+        self.widths = ({
+            NSInteger columnCount = 7;
+            size_t columnSize = sizeof(CGFloat)*columnCount;
+            CGFloat *widths = malloc(columnSize);
+            CGFloat contentWidth = self.collectionView.fs_width - self.sectionInsets.left - self.sectionInsets.right;
+            MMCalendarSliceCake(contentWidth, columnCount, widths);
+            widths;
+        });
+        
+        free(self.lefts);
+        self.lefts = ({
+            NSInteger columnCount = 7;
+            size_t columnSize = sizeof(CGFloat)*columnCount;
+            CGFloat *lefts = malloc(columnSize);
+            lefts[0] = self.sectionInsets.left;
+            for (int i = 1; i < columnCount; i++) {
+                lefts[i] = lefts[i-1] + self.widths[i-1];
+            }
+            lefts;
+        });
+    }
+    
+    if (invalidations & MMCalendarLayoutInvalidationRows) {
+        
         CGFloat height = ({
             CGFloat height = MMCalendarStandardRowHeight;
             if (!self.calendar.floatingMode) {
-                switch (self.calendar.transitionCoordinator.representingScope) {
+                switch (self.representingScope) {
                     case MMCalendarScopeMonth: {
                         height = (self.collectionView.fs_height-self.sectionInsets.top-self.sectionInsets.bottom)/6.0;
                         break;
@@ -134,61 +334,42 @@
             }
             height;
         });
-        CGSize size = CGSizeMake(width, height);
-        size;
-    });
-    
-    // Calculate item widths and lefts
-    free(self.widths);
-    self.widths = ({
-        NSInteger columnCount = 7;
-        size_t columnSize = sizeof(CGFloat)*columnCount;
-        CGFloat *widths = malloc(columnSize);
-        CGFloat contentWidth = self.collectionView.fs_width - self.sectionInsets.left - self.sectionInsets.right;
-        MMCalendarSliceCake(contentWidth, columnCount, widths);
-        widths;
-    });
-    
-    free(self.lefts);
-    self.lefts = ({
-        NSInteger columnCount = 7;
-        size_t columnSize = sizeof(CGFloat)*columnCount;
-        CGFloat *lefts = malloc(columnSize);
-        lefts[0] = self.sectionInsets.left;
-        for (int i = 1; i < columnCount; i++) {
-            lefts[i] = lefts[i-1] + self.widths[i-1];
-        }
-        lefts;
-    });
-    
-    // Calculate item heights and tops
-    free(self.heights);
-    self.heights = ({
-        NSInteger rowCount = self.calendar.transitionCoordinator.representingScope == MMCalendarScopeWeek ? 1 : 6;
-        size_t rowSize = sizeof(CGFloat)*rowCount;
-        CGFloat *heights = malloc(rowSize);
-        if (!self.calendar.floatingMode) {
-            CGFloat contentHeight = self.collectionView.fs_height - self.sectionInsets.top - self.sectionInsets.bottom;
-            MMCalendarSliceCake(contentHeight, rowCount, heights);
-        } else {
-            for (int i = 0; i < rowCount; i++) {
-                heights[i] = self.estimatedItemSize.height;
+        self.estimatedItemSize = CGSizeMake(self.estimatedItemSize.width, height);
+        
+        // Calculate item heights and tops
+        free(self.heights);
+        self.heights = ({
+            NSInteger rowCount = self.representingScope == MMCalendarScopeWeek ? 1 : 6;
+            size_t rowSize = sizeof(CGFloat)*rowCount;
+            CGFloat *heights = malloc(rowSize);
+            if (!self.calendar.floatingMode) {
+                CGFloat contentHeight = self.collectionView.fs_height - self.sectionInsets.top - self.sectionInsets.bottom;
+                MMCalendarSliceCake(contentHeight, rowCount, heights);
+            } else {
+                for (int i = 0; i < rowCount; i++) {
+                    heights[i] = self.estimatedItemSize.height;
+                }
             }
-        }
-        heights;
-    });
+            heights;
+        });
+        
+        free(self.tops);
+        self.tops = ({
+            NSInteger rowCount = self.representingScope == MMCalendarScopeWeek ? 1 : 6;
+            size_t rowSize = sizeof(CGFloat)*rowCount;
+            CGFloat *tops = malloc(rowSize);
+            tops[0] = self.sectionInsets.top;
+            for (int i = 1; i < rowCount; i++) {
+                tops[i] = tops[i-1] + self.heights[i-1];
+            }
+            tops;
+        });
+    }
     
-    free(self.tops);
-    self.tops = ({
-        NSInteger rowCount = self.calendar.transitionCoordinator.representingScope == MMCalendarScopeWeek ? 1 : 6;
-        size_t rowSize = sizeof(CGFloat)*rowCount;
-        CGFloat *tops = malloc(rowSize);
-        tops[0] = self.sectionInsets.top;
-        for (int i = 1; i < rowCount; i++) {
-            tops[i] = tops[i-1] + self.heights[i-1];
-        }
-        tops;
-    });
+    if (geometryChanged) {
+        // More floating sections fit on screen as rows get shorter
+        MMCalendarSectionPoolReset(&_pool, self.numberOfPooledSections);
+    }
     
     // Calculate content size
     self.numberOfSections = self.collectionView.numberOfSections;
@@ -211,38 +392,17 @@
             }
             contentSize = CGSizeMake(width, height);
         } else {
-            free(self.sectionHeights);
-            self.sectionHeights = malloc(sizeof(CGFloat)*self.numberOfSections);
-            free(self.sectionRowCounts);
-            self.sectionRowCounts = malloc(sizeof(NSInteger)*self.numberOfSections);
+            // Section offsets are derived from the calculator, nothing here grows with the number of sections
             CGFloat width = self.collectionView.fs_width;
-            CGFloat height = 0;
-            for (int i = 0; i < self.numberOfSections; i++) {
-                NSInteger rowCount = [self.calendar.calculator numberOfRowsInSection:i];
-                self.sectionRowCounts[i] = rowCount;
-                CGFloat sectionHeight = self.headerReferenceSize.height;
-                for (int j = 0; j < rowCount; j++) {
-                    sectionHeight += self.heights[j];
-                }
-                self.sectionHeights[i] = sectionHeight;
-                height += sectionHeight;
-            }
-            free(self.sectionTops);
-            self.sectionTops = malloc(sizeof(CGFloat)*self.numberOfSections);
-            free(self.sectionBottoms);
-            self.sectionBottoms = malloc(sizeof(CGFloat)*self.numberOfSections);
-            self.sectionTops[0] = 0;
-            self.sectionBottoms[0] = self.sectionHeights[0];
-            for (int i = 1; i < self.numberOfSections; i++) {
-                self.sectionTops[i] = self.sectionTops[i-1] + self.sectionHeights[i-1];
-                self.sectionBottoms[i] = self.sectionTops[i] + self.sectionHeights[i];
-            }
+            CGFloat height = [self topForSection:self.numberOfSections];
             contentSize = CGSizeMake(width, height);
         }
         contentSize;
     });
     
-    [self.calendar adjustMonthPosition];
+    if (geometryChanged || numberOfSectionsChanged || restored) {
+        [self.calendar adjustMonthPosition];
+    }
 }
 
 - (CGSize)collectionViewContentSize
@@ -289,24 +449,7 @@
                     endColumn;
                 });
                 
-                NSInteger numberOfRows = self.calendar.transitionCoordinator.representingScope == MMCalendarScopeMonth ? 6 : 1;
-                
-                for (NSInteger column = startColumn; column <= endColumn; column++) {
-                    for (NSInteger row = 0; row < numberOfRows; row++) {
-                        NSInteger section = column / 7;
-                        NSInteger item = column % 7 + row * 7;
-                        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-                        UICollectionViewLayoutAttributes *itemAttributes = [self layoutAttributesForItemAtIndexPath:indexPath];
-                        [layoutAttributes addObject:itemAttributes];
-                        
-                        UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:indexPath];
-                        if (rowSeparatorAttributes) {
-                            [layoutAttributes addObject:rowSeparatorAttributes];
-                        }
-                    }
-                }
-                
-                break;
+                return [self layoutAttributesForLinesFromLine:startColumn toLine:endColumn];
             }
             case UICollectionViewScrollDirectionVertical: {
                 
@@ -335,23 +478,7 @@
                     endRow;
                 });
                 
-                for (NSInteger row = startRow; row <= endRow; row++) {
-                    for (NSInteger column = 0; column < 7; column++) {
-                        NSInteger section = row / 6;
-                        NSInteger item = column + (row % 6) * 7;
-                        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-                        UICollectionViewLayoutAttributes *itemAttributes = [self layoutAttributesForItemAtIndexPath:indexPath];
-                        [layoutAttributes addObject:itemAttributes];
-                        
-                        UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:indexPath];
-                        if (rowSeparatorAttributes) {
-                            [layoutAttributes addObject:rowSeparatorAttributes];
-                        }
-                        
-                    }
-                }
-                
-                break;
+                return [self layoutAttributesForLinesFromLine:startRow toLine:endRow];
             }
             default:
                 break;
@@ -359,24 +486,25 @@
         
     } else {
         
-        NSInteger startSection = [self searchStartSection:rect :0 :self.numberOfSections-1];
+        NSInteger startSection = [self sectionAtOffset:CGRectGetMinY(rect) fromSection:0 inclusive:YES];
         NSInteger startRowIndex = ({
-            CGFloat heightDelta1 = MIN(self.sectionBottoms[startSection]-CGRectGetMinY(rect)-self.sectionInsets.bottom, self.sectionRowCounts[startSection]*self.estimatedItemSize.height);
+            NSInteger rowCount = [self.calendar.calculator numberOfRowsInSection:startSection];
+            CGFloat heightDelta1 = MIN([self bottomForSection:startSection]-CGRectGetMinY(rect)-self.sectionInsets.bottom, rowCount*self.estimatedItemSize.height);
             NSInteger startRowCount = MMCalendarCeil(heightDelta1/self.estimatedItemSize.height);
-            NSInteger startRowIndex = self.sectionRowCounts[startSection]-startRowCount;
+            NSInteger startRowIndex = rowCount-startRowCount;
             startRowIndex;
         });
         
-        NSInteger endSection = [self searchEndSection:rect :startSection :self.numberOfSections-1];
+        NSInteger endSection = [self sectionAtOffset:CGRectGetMaxY(rect) fromSection:startSection inclusive:NO];
         NSInteger endRowIndex = ({
-            CGFloat heightDelta2 = MAX(CGRectGetMaxY(rect) - self.sectionTops[endSection]- self.headerReferenceSize.height - self.sectionInsets.top, 0);
+            CGFloat heightDelta2 = MAX(CGRectGetMaxY(rect) - [self topForSection:endSection]- self.headerReferenceSize.height - self.sectionInsets.top, 0);
             NSInteger endRowCount = MMCalendarCeil(heightDelta2/self.estimatedItemSize.height);
             NSInteger endRowIndex = endRowCount - 1;
             endRowIndex;
         });
         for (NSInteger section = startSection; section <= endSection; section++) {
             NSInteger startRow = (section == startSection) ? startRowIndex : 0;
-            NSInteger endRow = (section == endSection) ? endRowIndex : self.sectionRowCounts[section]-1;
+            NSInteger endRow = (section == endSection) ? endRowIndex : [self.calendar.calculator numberOfRowsInSection:section]-1;
             UICollectionViewLayoutAttributes *headerAttributes = [self layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader atIndexPath:[NSIndexPath indexPathForItem:0 inSection:section]];
             [layoutAttributes addObject:headerAttributes];
             for (NSInteger row = startRow; row <= endRow; row++) {
@@ -385,10 +513,10 @@
                     NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
                     UICollectionViewLayoutAttributes *itemAttributes = [self layoutAttributesForItemAtIndexPath:indexPath];
                     [layoutAttributes addObject:itemAttributes];
-                    UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:indexPath];
-                    if (rowSeparatorAttributes) {
-                        [layoutAttributes addObject:rowSeparatorAttributes];
-                    }
+                }
+                UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:[NSIndexPath indexPathForItem:row inSection:section]];
+                if (rowSeparatorAttributes) {
+                    [layoutAttributes addObject:rowSeparatorAttributes];
                 }
             }
         }
@@ -404,6 +532,7 @@
     MMCalendarCoordinate coordinate = [self.calendar.calculator coordinateForIndexPath:indexPath];
     NSInteger column = coordinate.column;
     NSInteger row = coordinate.row;
+    [self poolSection:indexPath.section];
     UICollectionViewLayoutAttributes *attributes = self.itemAttributes[indexPath];
     if (!attributes) {
         attributes = [UICollectionViewLayoutAttributes layoutAttributesForCellWithIndexPath:indexPath];
@@ -420,7 +549,7 @@
                     if (!self.calendar.floatingMode) {
                         y = self.tops[row] + indexPath.section * self.collectionView.fs_height;
                     } else {
-                        y = self.sectionTops[indexPath.section] + self.headerReferenceSize.height + self.tops[row];
+                        y = [self topForSection:indexPath.section] + self.headerReferenceSize.height + self.tops[row];
                     }
                     break;
                 }
@@ -442,10 +571,11 @@
 - (UICollectionViewLayoutAttributes *)layoutAttributesForSupplementaryViewOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)indexPath
 {
     if ([elementKind isEqualToString:UICollectionElementKindSectionHeader]) {
+        [self poolSection:indexPath.section];
         UICollectionViewLayoutAttributes *attributes = self.headerAttributes[indexPath];
         if (!attributes) {
             attributes = [UICollectionViewLayoutAttributes layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader withIndexPath:indexPath];
-            attributes.frame = CGRectMake(0, self.sectionTops[indexPath.section], self.collectionView.fs_width, self.headerReferenceSize.height);
+            attributes.frame = CGRectMake(0, [self topForSection:indexPath.section], self.collectionView.fs_width, self.headerReferenceSize.height);
             self.headerAttributes[indexPath] = attributes;
         }
         return attributes;
@@ -453,14 +583,15 @@
     return nil;
 }
 
-// Separators
+// Separators, the item of the index path is the row above the separator
 - (UICollectionViewLayoutAttributes *)layoutAttributesForDecorationViewOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)indexPath
 {
     if ([elementKind isEqualToString:kMMCalendarSeparatorInterRows] && (self.separators & MMCalendarSeparatorInterRows)) {
+        [self poolSection:indexPath.section];
         UICollectionViewLayoutAttributes *attributes = self.rowSeparatorAttributes[indexPath];
         if (!attributes) {
-            MMCalendarCoordinate coordinate = [self.calendar.calculator coordinateForIndexPath:indexPath];
-            if (coordinate.row >= [self.calendar.calculator numberOfRowsInSection:indexPath.section]-1) {
+            NSInteger row = indexPath.item;
+            if (row < 0 || row >= [self.calendar.calculator numberOfRowsInSection:indexPath.section]-1) {
                 return nil;
             }
             attributes = [UICollectionViewLayoutAttributes layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows withIndexPath:indexPath];
@@ -468,13 +599,13 @@
             if (!self.calendar.floatingMode) {
                 switch (self.scrollDirection) {
                     case UICollectionViewScrollDirectionHorizontal: {
-                        x = self.lefts[coordinate.column] + indexPath.section * self.collectionView.fs_width;
-                        y = self.tops[coordinate.row]+self.heights[coordinate.row];
+                        x = indexPath.section * self.collectionView.fs_width;
+                        y = self.tops[row]+self.heights[row];
                         break;
                     }
                     case UICollectionViewScrollDirectionVertical: {
                         x = 0;
-                        y = self.tops[coordinate.row]+self.heights[coordinate.row] + indexPath.section * self.collectionView.fs_height;
+                        y = self.tops[row]+self.heights[row] + indexPath.section * self.collectionView.fs_height;
                         break;
                     }
                     default:
@@ -482,7 +613,7 @@
                 }
             } else {
                 x = 0;
-                y = self.sectionTops[indexPath.section] + self.headerReferenceSize.height + self.tops[coordinate.row] + self.heights[coordinate.row];
+                y = [self topForSection:indexPath.section] + self.headerReferenceSize.height + self.tops[row] + self.heights[row];
             }
             CGFloat width = self.collectionView.fs_width;
             CGFloat height = MMCalendarStandardSeparatorThickness;
@@ -503,9 +634,8 @@
         [self invalidateLayout];
     }
     if ([notification.name isEqualToString:UIApplicationDidReceiveMemoryWarningNotification]) {
-        [self.itemAttributes removeAllObjects];
-        [self.headerAttributes removeAllObjects];
-        [self.rowSeparatorAttributes removeAllObjects];
+        [self removeAllPooledAttributes];
+        self.savedScopeState = nil;
     }
 }
 
@@ -515,45 +645,217 @@
 {
     if (_scrollDirection != scrollDirection) {
         _scrollDirection = scrollDirection;
-        self.collectionViewSize = CGSizeAutomatic;
+        _pendingInvalidations = MMCalendarLayoutInvalidationAll;
     }
 }
 
 #pragma mark - Private functions
 
-- (NSInteger)searchStartSection:(CGRect)rect :(NSInteger)left :(NSInteger)right
+- (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForLinesFromLine:(NSInteger)firstLine toLine:(NSInteger)lastLine
 {
-    NSInteger mid = left + (right-left)/2;
-    CGFloat y = rect.origin.y;
-    CGFloat minY = self.sectionTops[mid];
-    CGFloat maxY = self.sectionBottoms[mid];
-    if (y >= minY && y < maxY) {
-        return mid;
-    } else if (y < minY) {
-        return [self searchStartSection:rect :left :mid];
-    } else {
-        return [self searchStartSection:rect :mid+1 :right];
+    MMCalendarScope scope = self.calendar.transitionCoordinator.representingScope;
+    NSInteger spanLastLine = self.spanFirstLine + (NSInteger)self.spanLines.count - 1;
+    if (scope != self.spanScope || lastLine < self.spanFirstLine || firstLine > spanLastLine) {
+        [self.spanLines removeAllObjects];
+        self.spanFirstLine = firstLine;
+        self.spanScope = scope;
+        spanLastLine = firstLine - 1;
+    } else if (firstLine == self.spanFirstLine && lastLine == spanLastLine && self.spanAttributes) {
+        // Asked again while the rect moved within the same lines
+        return self.spanAttributes;
+    }
+    // Only the lines that scrolled in are computed, the ones that stayed are moved over
+    if (lastLine < spanLastLine) {
+        [self.spanLines removeObjectsInRange:NSMakeRange(lastLine-self.spanFirstLine+1, spanLastLine-lastLine)];
+    }
+    if (firstLine > self.spanFirstLine) {
+        [self.spanLines removeObjectsInRange:NSMakeRange(0, firstLine-self.spanFirstLine)];
+    }
+    for (NSInteger line = MIN(self.spanFirstLine, lastLine+1)-1; line >= firstLine; line--) {
+        [self.spanLines insertObject:[self layoutAttributesForLine:line] atIndex:0];
+    }
+    for (NSInteger line = MAX(spanLastLine, firstLine-1)+1; line <= lastLine; line++) {
+        [self.spanLines addObject:[self layoutAttributesForLine:line]];
+    }
+    self.spanFirstLine = firstLine;
+    
+    [self.spanBuffer removeAllObjects];
+    for (NSArray<UICollectionViewLayoutAttributes *> *lineAttributes in self.spanLines) {
+        [self.spanBuffer addObjectsFromArray:lineAttributes];
+    }
+    if (self.scrollDirection == UICollectionViewScrollDirectionHorizontal) {
+        // A separator crosses the whole page, so it goes with the sections rather than with any column
+        for (NSInteger section = firstLine / 7; section <= lastLine / 7; section++) {
+            for (NSInteger row = 0; row < 5; row++) {
+                UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:[NSIndexPath indexPathForItem:row inSection:section]];
+                if (!rowSeparatorAttributes) break;
+                [self.spanBuffer addObject:rowSeparatorAttributes];
+            }
+        }
     }
+    self.spanAttributes = [self.spanBuffer copy];
+    return self.spanAttributes;
 }
 
-- (NSInteger)searchEndSection:(CGRect)rect :(NSInteger)left :(NSInteger)right
+- (NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForLine:(NSInteger)line
 {
-    NSInteger mid = left + (right-left)/2;
-    CGFloat y = CGRectGetMaxY(rect);
-    CGFloat minY = self.sectionTops[mid];
-    CGFloat maxY = self.sectionBottoms[mid];
-    if (y > minY && y <= maxY) {
-        return mid;
-    } else if (y <= minY) {
-        return [self searchEndSection:rect :left :mid];
-    } else {
-        return [self searchEndSection:rect :mid+1 :right];
+    NSMutableArray<UICollectionViewLayoutAttributes *> *layoutAttributes = [NSMutableArray arrayWithCapacity:8];
+    BOOL horizontal = self.scrollDirection == UICollectionViewScrollDirectionHorizontal;
+    NSInteger count = horizontal ? (self.spanScope == MMCalendarScopeMonth ? 6 : 1) : 7;
+    // A line is a column of a page when scrolling horizontally, a row of a page otherwise
+    NSInteger section = horizontal ? line / 7 : line / 6;
+    for (NSInteger i = 0; i < count; i++) {
+        NSInteger item = horizontal ? line % 7 + i * 7 : i + (line % 6) * 7;
+        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+        UICollectionViewLayoutAttributes *itemAttributes = [self layoutAttributesForItemAtIndexPath:indexPath];
+        [layoutAttributes addObject:itemAttributes];
+    }
+    if (!horizontal) {
+        UICollectionViewLayoutAttributes *rowSeparatorAttributes = [self layoutAttributesForDecorationViewOfKind:kMMCalendarSeparatorInterRows atIndexPath:[NSIndexPath indexPathForItem:line % 6 inSection:section]];
+        if (rowSeparatorAttributes) {
+            [layoutAttributes addObject:rowSeparatorAttributes];
+        }
+    }
+    return layoutAttributes;
+}
+
+- (void)poolSection:(NSInteger)section
+{
+    // Attributes of one section are asked for in a row
+    if (_pool.sections[_pool.lastSlot] == section) {
+        _pool.lastAccesses[_pool.lastSlot] = ++_pool.accessCount;
+        return;
+    }
+    NSInteger slot = 0;
+    for (NSInteger i = 0; i < _pool.capacity; i++) {
+        if (_pool.sections[i] == section) {
+            slot = i;
+            break;
+        }
+        if (_pool.lastAccesses[i] < _pool.lastAccesses[slot]) {
+            slot = i;
+        }
+    }
+    NSInteger evictedSection = _pool.sections[slot];
+    if (evictedSection != section && evictedSection != NSNotFound) {
+        // Frames are cheap to compute again from the column and row arrays, only the objects are kept
+        for (NSInteger item = 0; item < MMCalendarMaximumNumberOfDaysInPage; item++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:evictedSection];
+            [self.itemAttributes removeObjectForKey:indexPath];
+            if (item < 6) {
+                [self.rowSeparatorAttributes removeObjectForKey:indexPath];
+            }
+        }
+        [self.headerAttributes removeObjectForKey:[NSIndexPath indexPathForItem:0 inSection:evictedSection]];
     }
+    _pool.sections[slot] = section;
+    _pool.lastAccesses[slot] = ++_pool.accessCount;
+    _pool.lastSlot = slot;
+}
+
+- (void)removeAllPooledAttributes
+{
+    [self.itemAttributes removeAllObjects];
+    [self.headerAttributes removeAllObjects];
+    [self.rowSeparatorAttributes removeAllObjects];
+    [self.spanLines removeAllObjects];
+    self.spanAttributes = nil;
+    MMCalendarSectionPoolReset(&_pool, self.numberOfPooledSections);
+}
+
+- (NSInteger)numberOfPooledSections
+{
+    // Paging shows one section, and the next one while scrolling
+    NSInteger numberOfVisibleSections = 2;
+    if (self.calendar.floatingMode && self.estimatedItemSize.height > 0) {
+        // Floating months are stacked, each one 4 rows high at the fewest
+        NSInteger numberOfRows = self.representingScope == MMCalendarScopeWeek ? 1 : 4;
+        CGFloat sectionHeight = self.headerReferenceSize.height + numberOfRows*self.estimatedItemSize.height;
+        numberOfVisibleSections = MMCalendarCeil(self.collectionView.fs_height/sectionHeight) + 1;
+    }
+    return numberOfVisibleSections + MMCalendarNumberOfExtraPooledSections;
+}
+
+- (MMCalendarLayoutScopeState *)takeScopeState
+{
+    MMCalendarLayoutScopeState *state = [[MMCalendarLayoutScopeState alloc] init];
+    state.scope = self.representingScope;
+    state.collectionViewSize = self.collectionViewSize;
+    state.numberOfSections = self.numberOfSections;
+    state.scrollDirection = self.scrollDirection;
+    state.separators = self.separators;
+    
+    // Row geometry and attributes move over, columns and headers don't depend on the scope
+    state.heights = self.heights;
+    state.tops = self.tops;
+    state.estimatedItemHeight = self.estimatedItemSize.height;
+    state.contentSize = self.contentSize;
+    state.itemAttributes = self.itemAttributes;
+    state.rowSeparatorAttributes = self.rowSeparatorAttributes;
+    state.pool = _pool;
+    
+    self.heights = NULL;
+    self.tops = NULL;
+    self.itemAttributes = [NSMutableDictionary dictionary];
+    self.rowSeparatorAttributes = [NSMutableDictionary dictionary];
+    _pool = (MMCalendarSectionPool){0};
+    [self removeAllPooledAttributes];
+    return state;
+}
+
+- (BOOL)restoreScopeState:(MMCalendarLayoutScopeState *)state
+{
+    if (!state ||
+        state.scope != self.calendar.transitionCoordinator.representingScope ||
+        !CGSizeEqualToSize(state.collectionViewSize, self.collectionView.frame.size) ||
+        state.numberOfSections != self.collectionView.numberOfSections ||
+        state.scrollDirection != self.scrollDirection ||
+        state.separators != self.calendar.appearance.separators ||
+        self.collectionViewSize.width != state.collectionViewSize.width) {
+        return NO;
+    }
+    [self removeAllPooledAttributes];
+    self.representingScope = state.scope;
+    self.collectionViewSize = state.collectionViewSize;
+    self.numberOfSections = state.numberOfSections;
+    self.separators = state.separators;
+    
+    free(self.heights);
+    free(self.tops);
+    self.heights = state.heights;
+    self.tops = state.tops;
+    state.heights = NULL;
+    state.tops = NULL;
+    self.estimatedItemSize = CGSizeMake(self.estimatedItemSize.width, state.estimatedItemHeight);
+    self.contentSize = state.contentSize;
+    self.itemAttributes = state.itemAttributes;
+    self.rowSeparatorAttributes = state.rowSeparatorAttributes;
+    MMCalendarSectionPoolFree(&_pool);
+    _pool = state.pool;
+    state.pool = (MMCalendarSectionPool){0};
+    return YES;
+}
+
+- (CGFloat)topForSection:(NSInteger)section
+{
+    // Rows share the same height in floating mode
+    return [self.calendar.calculator topForSection:section headerHeight:self.headerReferenceSize.height rowHeight:self.estimatedItemSize.height];
+}
+
+- (CGFloat)bottomForSection:(NSInteger)section
+{
+    return [self topForSection:section+1];
+}
+
+- (NSInteger)sectionAtOffset:(CGFloat)offset fromSection:(NSInteger)firstSection inclusive:(BOOL)inclusive
+{
+    return [self.calendar.calculator sectionAtOffset:offset fromSection:firstSection numberOfSections:self.numberOfSections inclusive:inclusive headerHeight:self.headerReferenceSize.height rowHeight:self.estimatedItemSize.height];
 }
 
 @end
 
 
+#undef MMCalendarNumberOfExtraPooledSections
 #undef kMMCalendarSeparatorInterColumns
 #undef kMMCalendarSeparatorInterRows
 
@@ -0,0 +1,109 @@
+//
+//  MMCalendarDateEngine.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Integer day-number arithmetic used by MMCalendarCalculator.
+//  Dates are converted to day numbers once at the API boundary, everything in between is plain integer math.
+//  This file only depends on Foundation.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Number of days since 1970-01-01 in the time zone of the engine. Negative before 1970.
+ */
+typedef NSInteger MMCalendarDayNumber;
+
+typedef NS_ENUM(NSUInteger, MMCalendarArithmetic) {
+    MMCalendarArithmeticSystem,             // Month boundaries are resolved by NSCalendar
+    MMCalendarArithmeticGregorian,          // Month boundaries are resolved by integer arithmetic from here on
+    MMCalendarArithmeticIslamicCivil,
+    MMCalendarArithmeticIslamicTabular,
+    MMCalendarArithmeticIslamicUmmAlQura,   // Table driven for 1300-1600 AH, civil outside like NSCalendar
+    MMCalendarArithmeticPersian             // Arithmetic Solar Hijri
+};
+
+/**
+ * The first day number on which the proleptic Gregorian arithmetic matches NSCalendar (1582-10-15).
+ */
+FOUNDATION_EXPORT MMCalendarDayNumber const MMCalendarGregorianReformDayNumber;
+
+static inline NSInteger MMCalendarFloorDivide(NSInteger a, NSInteger b) {
+    return a >= 0 ? a/b : -((-a+b-1)/b);
+}
+
+static inline NSInteger MMCalendarFloorModulo(NSInteger a, NSInteger b) {
+    return a - MMCalendarFloorDivide(a, b)*b;
+}
+
+// http://howardhinnant.github.io/date_algorithms.html
+static inline MMCalendarDayNumber MMCalendarGregorianDayNumberFromCivil(NSInteger year, NSInteger month, NSInteger day) {
+    year -= month <= 2;
+    NSInteger era = MMCalendarFloorDivide(year, 400);
+    NSInteger yearOfEra = year - era * 400;
+    NSInteger dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    NSInteger dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static inline void MMCalendarGregorianCivilFromDayNumber(MMCalendarDayNumber dayNumber, NSInteger *year, NSInteger *month, NSInteger *day) {
+    NSInteger z = dayNumber + 719468;
+    NSInteger era = MMCalendarFloorDivide(z, 146097);
+    NSInteger dayOfEra = z - era * 146097;
+    NSInteger yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    NSInteger dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    NSInteger mp = (5 * dayOfYear + 2) / 153;
+    NSInteger m = mp < 10 ? mp + 3 : mp - 9;
+    if (year) *year = yearOfEra + era * 400 + (m <= 2);
+    if (month) *month = m;
+    if (day) *day = dayOfYear - (153 * mp + 2) / 5 + 1;
+}
+
+static inline NSInteger MMCalendarGregorianNumberOfDaysInMonth(NSInteger year, NSInteger month) {
+    static const NSInteger days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    BOOL leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return days[month-1] + (month == 2 && leap);
+}
+
+/**
+ * An immutable snapshot of a calendar (identifier, time zone and first weekday) that answers day-number questions.
+ *
+ * Month ordinals are consecutive integers, one per month. They are only meaningful relative to each other.
+ */
+@interface MMCalendarDateEngine : NSObject
+
+@property (readonly, nonatomic) NSCalendar *calendar;
+@property (readonly, nonatomic) NSTimeZone *timeZone;
+@property (readonly, nonatomic) NSUInteger firstWeekday;
+@property (readonly, nonatomic) MMCalendarArithmetic arithmetic;
+
+/**
+ * Creates an engine from a copy of the calendar. The arithmetic falls back to NSCalendar if the minimum day is not supported natively.
+ */
+- (instancetype)initWithCalendar:(NSCalendar *)calendar minimumDate:(nullable NSDate *)minimumDate NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (MMCalendarDayNumber)dayNumberForDate:(NSDate *)date;
+- (NSDate *)dateForDayNumber:(MMCalendarDayNumber)dayNumber;
+
+- (NSInteger)weekdayForDayNumber:(MMCalendarDayNumber)dayNumber; // 1 is Sunday, as in NSCalendar
+- (MMCalendarDayNumber)firstDayOfWeekForDayNumber:(MMCalendarDayNumber)dayNumber;
+
+- (NSInteger)monthOrdinalForDayNumber:(MMCalendarDayNumber)dayNumber;
+- (MMCalendarDayNumber)firstDayOfMonthOrdinal:(NSInteger)monthOrdinal;
+- (NSInteger)numberOfDaysInMonthOrdinal:(NSInteger)monthOrdinal;
+- (NSInteger)dayOfMonthForDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Counts the months in [fromOrdinal, toOrdinal) whose first day is the first weekday. Constant time for the native arithmetics.
+ */
+- (NSInteger)numberOfMonthsStartingWeeksFromMonthOrdinal:(NSInteger)fromOrdinal toMonthOrdinal:(NSInteger)toOrdinal;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,480 @@
+//
+//  MMCalendarDateEngine.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarDateEngine.h"
+
+#define MMCalendarSecondsPerDay 86400
+
+MMCalendarDayNumber const MMCalendarGregorianReformDayNumber = -141427;
+
+#pragma mark - Islamic kernels
+
+#define MMCalendarIslamicCivilEpoch -492148 // 622-07-16, Friday
+#define MMCalendarUmmAlQuraFirstYear 1300
+#define MMCalendarUmmAlQuraLastYear 1600
+
+// Month lengths of the Umm al-Qura years 1300-1600 AH, one bit per month (30 days if set) from Muharram in bit 11.
+// Bits 12-13 hold the offset of the first day of the year from the civil calendar, plus one.
+static const uint16_t MMCalendarUmmAlQuraYears[MMCalendarUmmAlQuraLastYear-MMCalendarUmmAlQuraFirstYear+1] = {
+    0x1AAA, 0x0D54, 0x0EC9, 0x16D4, 0x06EA, 0x136C, 0x1AAD, 0x1555, 0x16A9, 0x0792,
+    0x0BA9, 0x15D4, 0x0ADA, 0x155C, 0x1D2D, 0x1695, 0x174A, 0x0B54, 0x0B6A, 0x15AD,
+    0x14AE, 0x1A4F, 0x2517, 0x168B, 0x16A5, 0x1AD5, 0x12D6, 0x195B, 0x149D, 0x1A4D,
+    0x1D26, 0x0D95, 0x15AC, 0x19B6, 0x12BA, 0x1A5B, 0x252B, 0x1A95, 0x16CA, 0x0AE9,
+    0x12F4, 0x1976, 0x12B6, 0x1956, 0x1ACA, 0x0BA4, 0x0BD2, 0x05D9, 0x12DC, 0x196D,
+    0x154D, 0x1AA5, 0x1B52, 0x0BA5, 0x15B4, 0x19B6, 0x1557, 0x2297, 0x154B, 0x16A3,
+    0x1752, 0x0B65, 0x156A, 0x1AAB, 0x152B, 0x1C95, 0x1D4A, 0x0DA5, 0x15CA, 0x0AD6,
+    0x1957, 0x24AB, 0x194B, 0x1AA5, 0x1B52, 0x0B6A, 0x1575, 0x1276, 0x18B7, 0x245B,
+    0x1555, 0x15A9, 0x15B4, 0x09DA, 0x14DD, 0x226E, 0x1936, 0x1AAA, 0x0D54, 0x0DB2,
+    0x15D5, 0x12DA, 0x195B, 0x24AB, 0x1A55, 0x1B49, 0x1B64, 0x0B71, 0x15B4, 0x0AB5,
+    0x1A55, 0x1D25, 0x0E92, 0x0EC9, 0x16D4, 0x0AE9, 0x196B, 0x14AB, 0x1A93, 0x1D49,
+    0x0DA4, 0x0DB2, 0x1AB9, 0x14BA, 0x1A5B, 0x252B, 0x1A95, 0x1B2A, 0x0B55, 0x155C,
+    0x14BD, 0x123D, 0x191D, 0x1A95, 0x0B4A, 0x0B5A, 0x156D, 0x12B6, 0x193B, 0x149B,
+    0x1655, 0x16A9, 0x0754, 0x0B6A, 0x156C, 0x0AAD, 0x1555, 0x0B29, 0x0B92, 0x0BA9,
+    0x05D4, 0x0ADA, 0x155A, 0x0AAB, 0x1595, 0x1749, 0x0764, 0x0BAA, 0x05B5, 0x12B6,
+    0x1A56, 0x0E4D, 0x1B25, 0x1B52, 0x0B6A, 0x15AD, 0x22AE, 0x192F, 0x2497, 0x164B,
+    0x16A5, 0x16AC, 0x0AD6, 0x155D, 0x249D, 0x1A4D, 0x1D16, 0x0D95, 0x15AA, 0x15B5,
+    0x12DA, 0x195B, 0x24AD, 0x1595, 0x16CA, 0x16E4, 0x0AEA, 0x14F5, 0x12B6, 0x1956,
+    0x1AAA, 0x0B54, 0x0BD2, 0x15D9, 0x12EA, 0x196D, 0x24AD, 0x1A95, 0x1B4A, 0x0BA5,
+    0x15B2, 0x19B5, 0x14D6, 0x1A97, 0x2547, 0x1693, 0x1749, 0x0B55, 0x156A, 0x1A6B,
+    0x152B, 0x1A8B, 0x1D46, 0x0DA3, 0x15CA, 0x1AD6, 0x14DB, 0x226B, 0x194B, 0x1AA5,
+    0x1B52, 0x0B69, 0x1575, 0x2176, 0x18B7, 0x225B, 0x252B, 0x1565, 0x15B4, 0x09DA,
+    0x14ED, 0x216D, 0x18B6, 0x1AA6, 0x1D52, 0x0DA9, 0x15D4, 0x0ADA, 0x195B, 0x24AB,
+    0x1653, 0x1729, 0x1762, 0x0BA9, 0x15B2, 0x1AB5, 0x1555, 0x1B25, 0x0D92, 0x0EC9,
+    0x16D2, 0x0AE9, 0x156B, 0x24AB, 0x1A55, 0x1D29, 0x1D54, 0x0DAA, 0x19B5, 0x14BA,
+    0x1A3B, 0x249B, 0x1A4D, 0x1AAA, 0x1AD5, 0x12DA, 0x195D, 0x145E, 0x1A2E, 0x1C9A,
+    0x0D55, 0x16B2, 0x16B9, 0x14BA, 0x1A5D, 0x252D, 0x1A95, 0x1B52, 0x0BA8, 0x0BB4,
+    0x15B9, 0x12DA, 0x195A, 0x1B4A, 0x0DA4, 0x0ED1, 0x16E8, 0x0B6A, 0x156D, 0x1535,
+    0x1695, 0x1D4A, 0x0DA8, 0x0DD4, 0x16DA, 0x155B, 0x229D, 0x162B, 0x1B15, 0x1B4A,
+    0x0B95, 0x15AA, 0x1AAE, 0x192E, 0x1C8F, 0x2527, 0x1695, 0x16AA, 0x0AD6, 0x155D,
+    0x229D
+};
+
+// The tabular calendar counts from the day before the civil epoch
+static inline MMCalendarDayNumber MMCalendarIslamicYearStart(NSInteger year, MMCalendarDayNumber epoch)
+{
+    return epoch + (year - 1) * 354 + MMCalendarFloorDivide(3 + 11 * year, 30);
+}
+
+static inline MMCalendarDayNumber MMCalendarIslamicDayNumberFromCivil(NSInteger year, NSInteger month, NSInteger day, MMCalendarDayNumber epoch)
+{
+    return MMCalendarIslamicYearStart(year, epoch) + (59 * (month - 1) + 1) / 2 + day - 1;
+}
+
+static inline void MMCalendarIslamicCivilFromDayNumber(MMCalendarDayNumber dayNumber, MMCalendarDayNumber epoch, NSInteger *year, NSInteger *month, NSInteger *day)
+{
+    NSInteger y = MMCalendarFloorDivide(30 * (dayNumber - epoch) + 10646, 10631);
+    NSInteger dayOfYear = dayNumber - MMCalendarIslamicYearStart(y, epoch);
+    NSInteger m = MIN(2 * dayOfYear / 59, 11);
+    if (year) *year = y;
+    if (month) *month = m + 1;
+    if (day) *day = dayOfYear - (59 * m + 1) / 2 + 1;
+}
+
+static inline NSInteger MMCalendarIslamicNumberOfDaysInMonth(NSInteger year, NSInteger month)
+{
+    if (month < 12) return 30 - (month % 2 == 0);
+    return 29 + (MMCalendarFloorModulo(14 + 11 * year, 30) < 11);
+}
+
+static inline BOOL MMCalendarUmmAlQuraContainsYear(NSInteger year)
+{
+    return year >= MMCalendarUmmAlQuraFirstYear && year <= MMCalendarUmmAlQuraLastYear;
+}
+
+static inline MMCalendarDayNumber MMCalendarUmmAlQuraYearStart(NSInteger year)
+{
+    MMCalendarDayNumber yearStart = MMCalendarIslamicYearStart(year, MMCalendarIslamicCivilEpoch);
+    if (MMCalendarUmmAlQuraContainsYear(year)) {
+        yearStart += (MMCalendarUmmAlQuraYears[year-MMCalendarUmmAlQuraFirstYear] >> 12) - 1;
+    }
+    return yearStart;
+}
+
+static inline NSInteger MMCalendarUmmAlQuraNumberOfDaysInMonth(NSInteger year, NSInteger month)
+{
+    if (!MMCalendarUmmAlQuraContainsYear(year)) {
+        return MMCalendarIslamicNumberOfDaysInMonth(year, month);
+    }
+    return 29 + ((MMCalendarUmmAlQuraYears[year-MMCalendarUmmAlQuraFirstYear] >> (12 - month)) & 1);
+}
+
+static inline MMCalendarDayNumber MMCalendarUmmAlQuraDayNumberFromCivil(NSInteger year, NSInteger month, NSInteger day)
+{
+    if (!MMCalendarUmmAlQuraContainsYear(year)) {
+        return MMCalendarIslamicDayNumberFromCivil(year, month, day, MMCalendarIslamicCivilEpoch);
+    }
+    MMCalendarDayNumber dayNumber = MMCalendarUmmAlQuraYearStart(year);
+    for (NSInteger m = 1; m < month; m++) {
+        dayNumber += MMCalendarUmmAlQuraNumberOfDaysInMonth(year, m);
+    }
+    return dayNumber + day - 1;
+}
+
+static inline void MMCalendarUmmAlQuraCivilFromDayNumber(MMCalendarDayNumber dayNumber, NSInteger *year, NSInteger *month, NSInteger *day)
+{
+    // The table never moves a year start by more than a day, so the civil year is off by one at most
+    NSInteger y;
+    MMCalendarIslamicCivilFromDayNumber(dayNumber, MMCalendarIslamicCivilEpoch, &y, NULL, NULL);
+    if (dayNumber < MMCalendarUmmAlQuraYearStart(y)) {
+        y--;
+    } else if (dayNumber >= MMCalendarUmmAlQuraYearStart(y+1)) {
+        y++;
+    }
+    if (!MMCalendarUmmAlQuraContainsYear(y)) {
+        MMCalendarIslamicCivilFromDayNumber(dayNumber, MMCalendarIslamicCivilEpoch, year, month, day);
+        return;
+    }
+    NSInteger d = dayNumber - MMCalendarUmmAlQuraYearStart(y);
+    NSInteger m = 1;
+    while (m < 12 && d >= MMCalendarUmmAlQuraNumberOfDaysInMonth(y, m)) {
+        d -= MMCalendarUmmAlQuraNumberOfDaysInMonth(y, m);
+        m++;
+    }
+    if (year) *year = y;
+    if (month) *month = m;
+    if (day) *day = d + 1;
+}
+
+#pragma mark - Persian kernels
+
+#define MMCalendarPersianEpoch -492268 // 622-03-18 (Julian), the day before 1 Farvardin 1 as ICU counts from it
+
+// Arithmetic Solar Hijri, 8 leap years in every 33 years
+static inline MMCalendarDayNumber MMCalendarPersianYearStart(NSInteger year)
+{
+    return MMCalendarPersianEpoch + 365 * (year - 1) + MMCalendarFloorDivide(8 * year + 21, 33);
+}
+
+static inline MMCalendarDayNumber MMCalendarPersianDayNumberFromCivil(NSInteger year, NSInteger month, NSInteger day)
+{
+    NSInteger daysBeforeMonth = month <= 7 ? 31 * (month - 1) : 30 * (month - 1) + 6;
+    return MMCalendarPersianYearStart(year) + daysBeforeMonth + day - 1;
+}
+
+static inline void MMCalendarPersianCivilFromDayNumber(MMCalendarDayNumber dayNumber, NSInteger *year, NSInteger *month, NSInteger *day)
+{
+    NSInteger y = 1 + MMCalendarFloorDivide(33 * (dayNumber - MMCalendarPersianEpoch) + 3, 12053);
+    NSInteger dayOfYear = dayNumber - MMCalendarPersianYearStart(y);
+    NSInteger m = dayOfYear < 216 ? dayOfYear / 31 : (dayOfYear - 6) / 30;
+    if (year) *year = y;
+    if (month) *month = m + 1;
+    if (day) *day = dayOfYear - (m < 7 ? 31 * m : 30 * m + 6) + 1;
+}
+
+static inline NSInteger MMCalendarPersianNumberOfDaysInMonth(NSInteger year, NSInteger month)
+{
+    if (month <= 6) return 31;
+    if (month <= 11) return 30;
+    return 29 + (MMCalendarFloorModulo(25 * year + 11, 33) < 8);
+}
+
+#pragma mark - Native dispatch
+
+static inline void MMCalendarNativeCivilFromDayNumber(MMCalendarArithmetic arithmetic, MMCalendarDayNumber dayNumber, NSInteger *year, NSInteger *month, NSInteger *day)
+{
+    switch (arithmetic) {
+        case MMCalendarArithmeticGregorian:
+            MMCalendarGregorianCivilFromDayNumber(dayNumber, year, month, day);
+            break;
+        case MMCalendarArithmeticIslamicCivil:
+            MMCalendarIslamicCivilFromDayNumber(dayNumber, MMCalendarIslamicCivilEpoch, year, month, day);
+            break;
+        case MMCalendarArithmeticIslamicTabular:
+            MMCalendarIslamicCivilFromDayNumber(dayNumber, MMCalendarIslamicCivilEpoch-1, year, month, day);
+            break;
+        case MMCalendarArithmeticIslamicUmmAlQura:
+            MMCalendarUmmAlQuraCivilFromDayNumber(dayNumber, year, month, day);
+            break;
+        case MMCalendarArithmeticPersian:
+            MMCalendarPersianCivilFromDayNumber(dayNumber, year, month, day);
+            break;
+        default:
+            break;
+    }
+}
+
+static inline MMCalendarDayNumber MMCalendarNativeFirstDayOfMonthOrdinal(MMCalendarArithmetic arithmetic, NSInteger monthOrdinal)
+{
+    NSInteger year = MMCalendarFloorDivide(monthOrdinal, 12);
+    NSInteger month = MMCalendarFloorModulo(monthOrdinal, 12) + 1;
+    switch (arithmetic) {
+        case MMCalendarArithmeticGregorian:
+            return MMCalendarGregorianDayNumberFromCivil(year, month, 1);
+        case MMCalendarArithmeticIslamicCivil:
+            return MMCalendarIslamicDayNumberFromCivil(year, month, 1, MMCalendarIslamicCivilEpoch);
+        case MMCalendarArithmeticIslamicTabular:
+            return MMCalendarIslamicDayNumberFromCivil(year, month, 1, MMCalendarIslamicCivilEpoch-1);
+        case MMCalendarArithmeticIslamicUmmAlQura:
+            return MMCalendarUmmAlQuraDayNumberFromCivil(year, month, 1);
+        case MMCalendarArithmeticPersian:
+            return MMCalendarPersianDayNumberFromCivil(year, month, 1);
+        default:
+            return 0;
+    }
+}
+
+static inline NSInteger MMCalendarNativeNumberOfDaysInMonthOrdinal(MMCalendarArithmetic arithmetic, NSInteger monthOrdinal)
+{
+    NSInteger year = MMCalendarFloorDivide(monthOrdinal, 12);
+    NSInteger month = MMCalendarFloorModulo(monthOrdinal, 12) + 1;
+    switch (arithmetic) {
+        case MMCalendarArithmeticGregorian:
+            return MMCalendarGregorianNumberOfDaysInMonth(year, month);
+        case MMCalendarArithmeticIslamicCivil:
+        case MMCalendarArithmeticIslamicTabular:
+            return MMCalendarIslamicNumberOfDaysInMonth(year, month);
+        case MMCalendarArithmeticIslamicUmmAlQura:
+            return MMCalendarUmmAlQuraNumberOfDaysInMonth(year, month);
+        case MMCalendarArithmeticPersian:
+            return MMCalendarPersianNumberOfDaysInMonth(year, month);
+        default:
+            return 0;
+    }
+}
+
+// Number of months after which the weekdays of the month starts repeat
+static inline NSInteger MMCalendarNativeCycleMonths(MMCalendarArithmetic arithmetic)
+{
+    switch (arithmetic) {
+        case MMCalendarArithmeticGregorian:
+            return 4800; // 400 years, 146097 days
+        case MMCalendarArithmeticIslamicCivil:
+        case MMCalendarArithmeticIslamicTabular:
+            return 2520; // 210 years, 74417 days
+        case MMCalendarArithmeticPersian:
+            return 2772; // 231 years, 84371 days
+        default:
+            return 0;
+    }
+}
+
+// The first day on which the native arithmetic matches NSCalendar
+static inline MMCalendarDayNumber MMCalendarNativeMinimumDayNumber(MMCalendarArithmetic arithmetic)
+{
+    switch (arithmetic) {
+        case MMCalendarArithmeticGregorian:
+            return MMCalendarGregorianReformDayNumber;
+        case MMCalendarArithmeticIslamicCivil:
+        case MMCalendarArithmeticIslamicUmmAlQura:
+            return MMCalendarIslamicCivilEpoch;
+        case MMCalendarArithmeticIslamicTabular:
+            return MMCalendarIslamicCivilEpoch-1;
+        case MMCalendarArithmeticPersian:
+            return MMCalendarPersianEpoch;
+        default:
+            return NSIntegerMin;
+    }
+}
+
+@interface MMCalendarDateEngine ()
+
+@property (assign, nonatomic) BOOL hasFixedOffset;
+@property (assign, nonatomic) NSInteger fixedOffset;
+@property (strong, nonatomic) NSDate *referenceMonth;
+@property (assign, nonatomic) MMCalendarArithmetic cycleArithmetic;
+@property (assign, nonatomic) NSInteger cycleMonths;
+@property (assign, nonatomic) uint16_t *cycleWeekStarts;
+@property (assign, nonatomic) int16_t *tableWeekStarts;
+
+- (NSInteger)secondsFromGMTForDate:(NSDate *)date;
+- (NSInteger)numberOfMonthsStartingWeeksBeforeMonthOrdinal:(NSInteger)monthOrdinal;
+
+@end
+
+@implementation MMCalendarDateEngine
+
+- (instancetype)initWithCalendar:(NSCalendar *)calendar minimumDate:(NSDate *)minimumDate
+{
+    self = [super init];
+    if (self) {
+        _calendar = [calendar copy];
+        _timeZone = _calendar.timeZone;
+        _firstWeekday = _calendar.firstWeekday;
+
+        // Zones without any transition are resolved once, the others are looked up per conversion.
+        _hasFixedOffset = ![_timeZone nextDaylightSavingTimeTransitionAfterDate:[NSDate distantPast]];
+        _fixedOffset = [_timeZone secondsFromGMT];
+
+        _arithmetic = ({
+            NSString *identifier = _calendar.calendarIdentifier;
+            MMCalendarArithmetic arithmetic = MMCalendarArithmeticSystem;
+            if ([identifier isEqualToString:NSCalendarIdentifierGregorian]) {
+                arithmetic = MMCalendarArithmeticGregorian;
+            } else if ([identifier isEqualToString:NSCalendarIdentifierIslamicCivil]) {
+                arithmetic = MMCalendarArithmeticIslamicCivil;
+            } else if ([identifier isEqualToString:NSCalendarIdentifierIslamicTabular]) {
+                arithmetic = MMCalendarArithmeticIslamicTabular;
+            } else if ([identifier isEqualToString:NSCalendarIdentifierIslamicUmmAlQura]) {
+                arithmetic = MMCalendarArithmeticIslamicUmmAlQura;
+            } else if ([identifier isEqualToString:NSCalendarIdentifierPersian]) {
+                arithmetic = MMCalendarArithmeticPersian;
+            }
+            if (minimumDate && [self dayNumberForDate:minimumDate] < MMCalendarNativeMinimumDayNumber(arithmetic)) {
+                arithmetic = MMCalendarArithmeticSystem;
+            }
+            arithmetic;
+        });
+        if (_arithmetic == MMCalendarArithmeticSystem) {
+            NSDate *referenceMonth;
+            [_calendar rangeOfUnit:NSCalendarUnitMonth startDate:&referenceMonth interval:NULL forDate:[self dateForDayNumber:0]];
+            _referenceMonth = referenceMonth;
+        } else {
+            // Prefix counts of week-starting months over one cycle, the pattern repeats every cycle.
+            // Umm al-Qura follows the civil cycle outside of its table, the difference inside the table is counted separately.
+            _cycleArithmetic = _arithmetic == MMCalendarArithmeticIslamicUmmAlQura ? MMCalendarArithmeticIslamicCivil : _arithmetic;
+            _cycleMonths = MMCalendarNativeCycleMonths(_cycleArithmetic);
+            _cycleWeekStarts = malloc(sizeof(uint16_t)*(_cycleMonths+1));
+            _cycleWeekStarts[0] = 0;
+            for (NSInteger i = 0; i < _cycleMonths; i++) {
+                MMCalendarDayNumber firstDay = MMCalendarNativeFirstDayOfMonthOrdinal(_cycleArithmetic, i);
+                _cycleWeekStarts[i+1] = _cycleWeekStarts[i] + ([self weekdayForDayNumber:firstDay] == _firstWeekday);
+            }
+            if (_arithmetic == MMCalendarArithmeticIslamicUmmAlQura) {
+                NSInteger firstOrdinal = MMCalendarUmmAlQuraFirstYear * 12;
+                NSInteger count = (MMCalendarUmmAlQuraLastYear - MMCalendarUmmAlQuraFirstYear + 1) * 12;
+                _tableWeekStarts = malloc(sizeof(int16_t)*(count+1));
+                _tableWeekStarts[0] = 0;
+                for (NSInteger i = 0; i < count; i++) {
+                    BOOL tableStart = [self weekdayForDayNumber:MMCalendarNativeFirstDayOfMonthOrdinal(_arithmetic, firstOrdinal+i)] == _firstWeekday;
+                    BOOL cycleStart = [self weekdayForDayNumber:MMCalendarNativeFirstDayOfMonthOrdinal(_cycleArithmetic, firstOrdinal+i)] == _firstWeekday;
+                    _tableWeekStarts[i+1] = _tableWeekStarts[i] + tableStart - cycleStart;
+                }
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_cycleWeekStarts);
+    free(_tableWeekStarts);
+}
+
+#pragma mark - Conversion
+
+- (MMCalendarDayNumber)dayNumberForDate:(NSDate *)date
+{
+    NSTimeInterval local = date.timeIntervalSince1970 + [self secondsFromGMTForDate:date];
+    return (MMCalendarDayNumber)floor(local / MMCalendarSecondsPerDay);
+}
+
+- (NSDate *)dateForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    NSTimeInterval midnight = (NSTimeInterval)dayNumber * MMCalendarSecondsPerDay;
+    if (_hasFixedOffset) {
+        return [NSDate dateWithTimeIntervalSince1970:midnight-_fixedOffset];
+    }
+    NSInteger offset = [self secondsFromGMTForDate:[NSDate dateWithTimeIntervalSince1970:midnight]];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:midnight-offset];
+    NSInteger actualOffset = [self secondsFromGMTForDate:date];
+    if (actualOffset != offset) {
+        date = [NSDate dateWithTimeIntervalSince1970:midnight-actualOffset];
+    }
+    if ([self dayNumberForDate:date] != dayNumber) {
+        // Midnight is skipped by a transition, use the first instant of the day instead.
+        date = [_calendar startOfDayForDate:[NSDate dateWithTimeIntervalSince1970:midnight-offset+MMCalendarSecondsPerDay/2]];
+    }
+    return date;
+}
+
+#pragma mark - Weeks
+
+- (NSInteger)weekdayForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    // 1970-01-01 is a Thursday
+    return MMCalendarFloorModulo(dayNumber + 4, 7) + 1;
+}
+
+- (MMCalendarDayNumber)firstDayOfWeekForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    NSInteger weekday = [self weekdayForDayNumber:dayNumber];
+    return dayNumber - MMCalendarFloorModulo(weekday - (NSInteger)_firstWeekday, 7);
+}
+
+#pragma mark - Months
+
+- (NSInteger)monthOrdinalForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    if (_arithmetic == MMCalendarArithmeticSystem) {
+        NSDate *month;
+        [_calendar rangeOfUnit:NSCalendarUnitMonth startDate:&month interval:NULL forDate:[self dateForDayNumber:dayNumber]];
+        return [_calendar components:NSCalendarUnitMonth fromDate:_referenceMonth toDate:month options:0].month;
+    }
+    NSInteger year, month;
+    MMCalendarNativeCivilFromDayNumber(_arithmetic, dayNumber, &year, &month, NULL);
+    return year * 12 + month - 1;
+}
+
+- (MMCalendarDayNumber)firstDayOfMonthOrdinal:(NSInteger)monthOrdinal
+{
+    if (_arithmetic == MMCalendarArithmeticSystem) {
+        NSDate *month = [_calendar dateByAddingUnit:NSCalendarUnitMonth value:monthOrdinal toDate:_referenceMonth options:0];
+        return [self dayNumberForDate:month];
+    }
+    return MMCalendarNativeFirstDayOfMonthOrdinal(_arithmetic, monthOrdinal);
+}
+
+- (NSInteger)numberOfDaysInMonthOrdinal:(NSInteger)monthOrdinal
+{
+    if (_arithmetic == MMCalendarArithmeticSystem) {
+        return [self firstDayOfMonthOrdinal:monthOrdinal+1] - [self firstDayOfMonthOrdinal:monthOrdinal];
+    }
+    return MMCalendarNativeNumberOfDaysInMonthOrdinal(_arithmetic, monthOrdinal);
+}
+
+- (NSInteger)dayOfMonthForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    if (_arithmetic == MMCalendarArithmeticSystem) {
+        return [_calendar component:NSCalendarUnitDay fromDate:[self dateForDayNumber:dayNumber]];
+    }
+    NSInteger day;
+    MMCalendarNativeCivilFromDayNumber(_arithmetic, dayNumber, NULL, NULL, &day);
+    return day;
+}
+
+- (NSInteger)numberOfMonthsStartingWeeksFromMonthOrdinal:(NSInteger)fromOrdinal toMonthOrdinal:(NSInteger)toOrdinal
+{
+    if (toOrdinal <= fromOrdinal) return 0;
+    if (_arithmetic == MMCalendarArithmeticSystem) {
+        NSInteger count = 0;
+        for (NSInteger monthOrdinal = fromOrdinal; monthOrdinal < toOrdinal; monthOrdinal++) {
+            count += [self weekdayForDayNumber:[self firstDayOfMonthOrdinal:monthOrdinal]] == _firstWeekday;
+        }
+        return count;
+    }
+    return [self numberOfMonthsStartingWeeksBeforeMonthOrdinal:toOrdinal] - [self numberOfMonthsStartingWeeksBeforeMonthOrdinal:fromOrdinal];
+}
+
+#pragma mark - Private methods
+
+- (NSInteger)numberOfMonthsStartingWeeksBeforeMonthOrdinal:(NSInteger)monthOrdinal
+{
+    NSInteger cycle = MMCalendarFloorDivide(monthOrdinal, _cycleMonths);
+    NSInteger offset = monthOrdinal - cycle * _cycleMonths;
+    NSInteger count = cycle * _cycleWeekStarts[_cycleMonths] + _cycleWeekStarts[offset];
+    if (_tableWeekStarts) {
+        NSInteger index = monthOrdinal - MMCalendarUmmAlQuraFirstYear * 12;
+        index = MIN(MAX(index, 0), (MMCalendarUmmAlQuraLastYear - MMCalendarUmmAlQuraFirstYear + 1) * 12);
+        count += _tableWeekStarts[index];
+    }
+    return count;
+}
+
+- (NSInteger)secondsFromGMTForDate:(NSDate *)date
+{
+    return _hasFixedOffset ? _fixedOffset : [_timeZone secondsFromGMTForDate:date];
+}
+
+@end
+
+#undef MMCalendarSecondsPerDay
+#undef MMCalendarIslamicCivilEpoch
+#undef MMCalendarUmmAlQuraFirstYear
+#undef MMCalendarUmmAlQuraLastYear
+#undef MMCalendarPersianEpoch
@@ -0,0 +1,48 @@
+//
+//  MMCalendarDayAppearance.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Private header, don't use it.
+//
+
+#import <UIKit/UIKit.h>
+
+@class MMCalendarCell;
+
+typedef NS_OPTIONS(NSUInteger, MMCalendarDayAppearanceParts) {
+    MMCalendarDayAppearancePartBase     = 1 << 0, // Fill, title and border
+    MMCalendarDayAppearancePartSubtitle = 1 << 1,
+    MMCalendarDayAppearancePartEvent    = 1 << 2,
+    MMCalendarDayAppearancePartImage    = 1 << 3
+};
+
+/**
+ * The answers of MMCalendarDelegateAppearance for one day. Parts are only asked for once a cell of the day shows them.
+ */
+@interface MMCalendarDayAppearance : NSObject
+
+@property (assign, nonatomic) MMCalendarDayAppearanceParts resolvedParts;
+
+@property (strong, nonatomic) UIColor *preferredFillDefaultColor;
+@property (strong, nonatomic) UIColor *preferredFillSelectionColor;
+@property (strong, nonatomic) UIColor *preferredTitleDefaultColor;
+@property (strong, nonatomic) UIColor *preferredTitleSelectionColor;
+@property (strong, nonatomic) UIColor *preferredSubtitleDefaultColor;
+@property (strong, nonatomic) UIColor *preferredSubtitleSelectionColor;
+@property (strong, nonatomic) UIColor *preferredBorderDefaultColor;
+@property (strong, nonatomic) UIColor *preferredBorderSelectionColor;
+@property (assign, nonatomic) CGPoint preferredTitleOffset;
+@property (assign, nonatomic) CGPoint preferredSubtitleOffset;
+@property (assign, nonatomic) CGPoint preferredImageOffset;
+@property (assign, nonatomic) CGPoint preferredEventOffset;
+
+@property (strong, nonatomic) NSArray<UIColor *> *preferredEventDefaultColors;
+@property (strong, nonatomic) NSArray<UIColor *> *preferredEventSelectionColors;
+@property (assign, nonatomic) CGFloat preferredBorderRadius;
+
+- (void)applyParts:(MMCalendarDayAppearanceParts)parts toCell:(MMCalendarCell *)cell;
+
+@end
@@ -0,0 +1,41 @@
+//
+//  MMCalendarDayAppearance.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarDayAppearance.h"
+#import "MMCalendarCell.h"
+
+@implementation MMCalendarDayAppearance
+
+- (void)applyParts:(MMCalendarDayAppearanceParts)parts toCell:(MMCalendarCell *)cell
+{
+    if (parts & MMCalendarDayAppearancePartBase) {
+        cell.preferredFillDefaultColor = self.preferredFillDefaultColor;
+        cell.preferredFillSelectionColor = self.preferredFillSelectionColor;
+        cell.preferredTitleDefaultColor = self.preferredTitleDefaultColor;
+        cell.preferredTitleSelectionColor = self.preferredTitleSelectionColor;
+        cell.preferredTitleOffset = self.preferredTitleOffset;
+        cell.preferredBorderDefaultColor = self.preferredBorderDefaultColor;
+        cell.preferredBorderSelectionColor = self.preferredBorderSelectionColor;
+        cell.preferredBorderRadius = self.preferredBorderRadius;
+    }
+    if (parts & MMCalendarDayAppearancePartSubtitle) {
+        cell.preferredSubtitleDefaultColor = self.preferredSubtitleDefaultColor;
+        cell.preferredSubtitleSelectionColor = self.preferredSubtitleSelectionColor;
+        cell.preferredSubtitleOffset = self.preferredSubtitleOffset;
+    }
+    if (parts & MMCalendarDayAppearancePartEvent) {
+        cell.preferredEventDefaultColors = self.preferredEventDefaultColors;
+        cell.preferredEventSelectionColors = self.preferredEventSelectionColors;
+        cell.preferredEventOffset = self.preferredEventOffset;
+    }
+    if (parts & MMCalendarDayAppearancePartImage) {
+        cell.preferredImageOffset = self.preferredImageOffset;
+    }
+}
+
+@end
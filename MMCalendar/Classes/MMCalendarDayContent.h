@@ -0,0 +1,38 @@
+//
+//  MMCalendarDayContent.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Per-day record filled by -calendar:contentForDatesInRange:into:
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * What the data source shows on one day. The calendar hands out the same records page after page, so everything is cleared before they are filled again.
+ */
+@interface MMCalendarDayContent : NSObject
+
+/**
+ * The day this record stands for.
+ */
+@property (readonly, nonatomic) NSDate *date;
+
+/**
+ * Replaces the day text, the day of month is shown when nil.
+ */
+@property (nullable, copy, nonatomic) NSString *title;
+
+@property (nullable, copy, nonatomic) NSString *subtitle;
+
+@property (nullable, strong, nonatomic) UIImage *image;
+
+@property (assign, nonatomic) NSInteger numberOfEvents;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,28 @@
+//
+//  MMCalendarDayContent.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarDayContent.h"
+#import "MMCalendarDynamicHeader.h"
+
+@implementation MMCalendarDayContent
+
+- (void)prepareForDate:(NSDate *)date
+{
+    _date = date;
+    _title = nil;
+    _subtitle = nil;
+    _image = nil;
+    _numberOfEvents = 0;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; date = %@; title = %@; subtitle = %@; numberOfEvents = %@>", self.class, self, self.date, self.title, self.subtitle, @(self.numberOfEvents)];
+}
+
+@end
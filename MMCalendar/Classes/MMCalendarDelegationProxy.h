@@ -9,6 +9,7 @@
 //
 //  1. Smart proxy delegation http://petersteinberger.com/blog/2013/smart-proxy-delegation/
 //  2. Manage deprecated delegation functions
+//  3. Resolve the implementations once per delegation and call them without NSInvocation
 //
 
 #import <Foundation/Foundation.h>
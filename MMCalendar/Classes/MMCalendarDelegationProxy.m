@@ -9,6 +9,38 @@
 #import "MMCalendarDelegationProxy.h"
 #import <objc/runtime.h>
 
+// Power of two, at least twice the number of methods in the protocols
+#define MMCalendarDelegationTableSize 128
+
+typedef struct MMCalendarDelegationEntry {
+    SEL selector;       // A selector of the protocol, NULL for an empty slot
+    SEL targetSelector; // The selector itself, or its deprecated counterpart if the delegation only implements that
+    IMP implementation; // NULL if the delegation implements neither
+} MMCalendarDelegationEntry;
+
+static inline MMCalendarDelegationEntry *MMCalendarDelegationEntryForSelector(MMCalendarDelegationEntry *entries, SEL selector)
+{
+    if (!entries) return NULL;
+    NSUInteger index = ((uintptr_t)selector >> 3) & (MMCalendarDelegationTableSize-1);
+    while (entries[index].selector) {
+        if (entries[index].selector == selector) {
+            return entries + index;
+        }
+        index = (index+1) & (MMCalendarDelegationTableSize-1);
+    }
+    return NULL;
+}
+
+@interface MMCalendarDelegationProxy ()
+
+// Open addressed by selector, rebuilt whenever the delegation, the protocol or the deprecations change
+@property (assign, nonatomic) MMCalendarDelegationEntry *entries;
+
+- (void)resolveImplementations;
+- (void)addSelectorsOfProtocol:(Protocol *)protocol;
+
+@end
+
 @implementation MMCalendarDelegationProxy
 
 - (instancetype)init
@@ -16,8 +48,35 @@
     return self;
 }
 
+- (void)dealloc
+{
+    free(_entries);
+}
+
+- (void)setDelegation:(id)delegation
+{
+    _delegation = delegation;
+    [self resolveImplementations];
+}
+
+- (void)setProtocol:(Protocol *)protocol
+{
+    _protocol = protocol;
+    [self resolveImplementations];
+}
+
+- (void)setDeprecations:(NSDictionary<NSString *,NSString *> *)deprecations
+{
+    _deprecations = deprecations;
+    [self resolveImplementations];
+}
+
 - (BOOL)respondsToSelector:(SEL)selector
 {
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, selector);
+    if (entry) {
+        return entry->implementation && _delegation;
+    }
     BOOL responds = [self.delegation respondsToSelector:selector];
     if (!responds) responds = [self.delegation respondsToSelector:[self deprecatedSelectorOfSelector:selector]];
     if (!responds) responds = [super respondsToSelector:selector];
@@ -31,6 +90,14 @@
 
 - (void)forwardInvocation:(NSInvocation *)invocation
 {
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, invocation.selector);
+    if (entry) {
+        if (entry->implementation) {
+            invocation.selector = entry->targetSelector;
+            [invocation invokeWithTarget:self.delegation];
+        }
+        return;
+    }
     SEL selector = invocation.selector;
     if (![self.delegation respondsToSelector:selector]) {
         selector = [self deprecatedSelectorOfSelector:selector];
@@ -43,12 +110,18 @@
 
 - (NSMethodSignature *)methodSignatureForSelector:(SEL)sel
 {
-    if ([self.delegation respondsToSelector:sel]) {
-        return [(NSObject *)self.delegation methodSignatureForSelector:sel];
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, sel);
+    if (entry && entry->implementation) {
+        return [(NSObject *)self.delegation methodSignatureForSelector:entry->targetSelector];
     }
-    SEL selector = [self deprecatedSelectorOfSelector:sel];
-    if ([self.delegation respondsToSelector:selector]) {
-        return [(NSObject *)self.delegation methodSignatureForSelector:selector];
+    if (!entry) {
+        if ([self.delegation respondsToSelector:sel]) {
+            return [(NSObject *)self.delegation methodSignatureForSelector:sel];
+        }
+        SEL selector = [self deprecatedSelectorOfSelector:sel];
+        if ([self.delegation respondsToSelector:selector]) {
+            return [(NSObject *)self.delegation methodSignatureForSelector:selector];
+        }
     }
 #if TARGET_INTERFACE_BUILDER
     return [NSObject methodSignatureForSelector:@selector(init)];
@@ -65,4 +138,239 @@
     return NSSelectorFromString(selectorString);
 }
 
+#pragma mark - Private methods
+
+- (void)resolveImplementations
+{
+    if (!_entries) {
+        _entries = calloc(MMCalendarDelegationTableSize, sizeof(MMCalendarDelegationEntry));
+    } else {
+        memset(_entries, 0, MMCalendarDelegationTableSize*sizeof(MMCalendarDelegationEntry));
+    }
+    if (!_protocol) return;
+    [self addSelectorsOfProtocol:_protocol];
+}
+
+- (void)addSelectorsOfProtocol:(Protocol *)protocol
+{
+    if (protocol_isEqual(protocol, @protocol(NSObject))) return;
+    id delegation = self.delegation;
+    Class delegationClass = object_getClass(delegation);
+    for (NSInteger required = 0; required < 2; required++) {
+        unsigned int numberOfMethods = 0;
+        struct objc_method_description *methods = protocol_copyMethodDescriptionList(protocol, required, YES, &numberOfMethods);
+        for (unsigned int i = 0; i < numberOfMethods; i++) {
+            SEL selector = methods[i].name;
+            NSUInteger index = ((uintptr_t)selector >> 3) & (MMCalendarDelegationTableSize-1);
+            while (_entries[index].selector && _entries[index].selector != selector) {
+                index = (index+1) & (MMCalendarDelegationTableSize-1);
+            }
+            MMCalendarDelegationEntry *entry = _entries + index;
+            entry->selector = selector;
+            if ([delegation respondsToSelector:selector]) {
+                entry->targetSelector = selector;
+            } else {
+                SEL deprecatedSelector = [self deprecatedSelectorOfSelector:selector];
+                entry->targetSelector = deprecatedSelector && [delegation respondsToSelector:deprecatedSelector] ? deprecatedSelector : NULL;
+            }
+            // Delegations forwarding the message themselves get the forwarding trampoline, which behaves the same
+            entry->implementation = entry->targetSelector ? class_getMethodImplementation(delegationClass, entry->targetSelector) : NULL;
+        }
+        free(methods);
+    }
+    unsigned int numberOfProtocols = 0;
+    Protocol * __unsafe_unretained *protocols = protocol_copyProtocolList(protocol, &numberOfProtocols);
+    for (unsigned int i = 0; i < numberOfProtocols; i++) {
+        [self addSelectorsOfProtocol:protocols[i]];
+    }
+    free(protocols);
+}
+
+#pragma mark - Direct calls
+
+/*
+ * The calendar's own messages land here instead of going through forwardInvocation:, the resolved implementation is called without building an invocation.
+ * Deprecated counterparts taking fewer arguments or returning another type are called with their own signature.
+ */
+
+#define MMCalendarDelegationInvoke(TYPE, DEFAULT, ...) \
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd); \
+    id delegation = _delegation; \
+    if (!entry || !entry->implementation || !delegation) return DEFAULT; \
+    return ((TYPE)entry->implementation)(delegation, entry->targetSelector, __VA_ARGS__);
+
+#define MMCalendarDelegationPerform(TYPE, ...) \
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd); \
+    id delegation = _delegation; \
+    if (!entry || !entry->implementation || !delegation) return; \
+    ((TYPE)entry->implementation)(delegation, entry->targetSelector, __VA_ARGS__);
+
+typedef id (*MMCalendarObjectIMP)(id, SEL, MMCalendar *);
+typedef id (*MMCalendarObjectForDateIMP)(id, SEL, MMCalendar *, NSDate *);
+typedef id (*MMCalendarObjectForDatePositionIMP)(id, SEL, MMCalendar *, NSDate *, MMCalendarMonthPosition);
+typedef NSInteger (*MMCalendarIntegerForDateIMP)(id, SEL, MMCalendar *, NSDate *);
+typedef BOOL (*MMCalendarBoolForDateIMP)(id, SEL, MMCalendar *, NSDate *);
+typedef BOOL (*MMCalendarBoolForDatePositionIMP)(id, SEL, MMCalendar *, NSDate *, MMCalendarMonthPosition);
+typedef void (*MMCalendarVoidIMP)(id, SEL, MMCalendar *);
+typedef void (*MMCalendarVoidForObjectIMP)(id, SEL, MMCalendar *, id);
+typedef void (*MMCalendarVoidForObjectsIMP)(id, SEL, MMCalendar *, id, id);
+typedef void (*MMCalendarVoidForPrefetchIMP)(id, SEL, MMCalendar *, id, id, NSProgress *, void (^)(void));
+typedef void (*MMCalendarVoidForDatePositionIMP)(id, SEL, MMCalendar *, NSDate *, MMCalendarMonthPosition);
+typedef void (*MMCalendarVoidForCellIMP)(id, SEL, MMCalendar *, MMCalendarCell *, NSDate *, MMCalendarMonthPosition);
+typedef void (*MMCalendarVoidForRectIMP)(id, SEL, MMCalendar *, CGRect, BOOL);
+typedef id (*MMCalendarAppearanceObjectIMP)(id, SEL, MMCalendar *, MMCalendarAppearance *, NSDate *);
+typedef CGPoint (*MMCalendarAppearancePointIMP)(id, SEL, MMCalendar *, MMCalendarAppearance *, NSDate *);
+typedef CGFloat (*MMCalendarAppearanceFloatIMP)(id, SEL, MMCalendar *, MMCalendarAppearance *, NSDate *);
+
+#pragma mark MMCalendarDataSource
+
+- (NSString *)calendar:(MMCalendar *)calendar titleForDate:(NSDate *)date
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectForDateIMP, nil, calendar, date);
+}
+
+- (NSString *)calendar:(MMCalendar *)calendar subtitleForDate:(NSDate *)date
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectForDateIMP, nil, calendar, date);
+}
+
+- (UIImage *)calendar:(MMCalendar *)calendar imageForDate:(NSDate *)date
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectForDateIMP, nil, calendar, date);
+}
+
+- (NSDate *)minimumDateForCalendar:(MMCalendar *)calendar
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectIMP, nil, calendar);
+}
+
+- (NSDate *)maximumDateForCalendar:(MMCalendar *)calendar
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectIMP, nil, calendar);
+}
+
+- (MMCalendarCell *)calendar:(MMCalendar *)calendar cellForDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)position
+{
+    MMCalendarDelegationInvoke(MMCalendarObjectForDatePositionIMP, nil, calendar, date, position);
+}
+
+- (NSInteger)calendar:(MMCalendar *)calendar numberOfEventsForDate:(NSDate *)date
+{
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd);
+    if (entry && entry->implementation && entry->targetSelector != _cmd) {
+        // calendar:hasEventForDate:
+        id delegation = _delegation;
+        return delegation ? ((MMCalendarBoolForDateIMP)entry->implementation)(delegation, entry->targetSelector, calendar, date) : 0;
+    }
+    MMCalendarDelegationInvoke(MMCalendarIntegerForDateIMP, 0, calendar, date);
+}
+
+- (void)calendar:(MMCalendar *)calendar contentForDatesInRange:(NSDateInterval *)range into:(NSArray<MMCalendarDayContent *> *)contents
+{
+    MMCalendarDelegationPerform(MMCalendarVoidForObjectsIMP, calendar, range, contents);
+}
+
+- (void)calendar:(MMCalendar *)calendar prefetchContentForDatesInRange:(NSDateInterval *)range into:(NSArray<MMCalendarDayContent *> *)contents progress:(NSProgress *)progress completion:(void (^)(void))completion
+{
+    MMCalendarDelegationPerform(MMCalendarVoidForPrefetchIMP, calendar, range, contents, progress, completion);
+}
+
+#pragma mark MMCalendarDelegate
+
+- (BOOL)calendar:(MMCalendar *)calendar shouldSelectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd);
+    if (entry && entry->implementation && entry->targetSelector != _cmd) {
+        // calendar:shouldSelectDate:
+        id delegation = _delegation;
+        return delegation ? ((MMCalendarBoolForDateIMP)entry->implementation)(delegation, entry->targetSelector, calendar, date) : NO;
+    }
+    MMCalendarDelegationInvoke(MMCalendarBoolForDatePositionIMP, NO, calendar, date, monthPosition);
+}
+
+- (void)calendar:(MMCalendar *)calendar didSelectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd);
+    if (entry && entry->implementation && entry->targetSelector != _cmd) {
+        // calendar:didSelectDate:
+        id delegation = _delegation;
+        if (delegation) ((MMCalendarVoidForObjectIMP)entry->implementation)(delegation, entry->targetSelector, calendar, date);
+        return;
+    }
+    MMCalendarDelegationPerform(MMCalendarVoidForDatePositionIMP, calendar, date, monthPosition);
+}
+
+- (void)calendar:(MMCalendar *)calendar didSelectDates:(NSArray<NSDate *> *)dates
+{
+    MMCalendarDelegationPerform(MMCalendarVoidForObjectIMP, calendar, dates);
+}
+
+- (BOOL)calendar:(MMCalendar *)calendar shouldDeselectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd);
+    if (entry && entry->implementation && entry->targetSelector != _cmd) {
+        // calendar:shouldDeselectDate:
+        id delegation = _delegation;
+        return delegation ? ((MMCalendarBoolForDateIMP)entry->implementation)(delegation, entry->targetSelector, calendar, date) : NO;
+    }
+    MMCalendarDelegationInvoke(MMCalendarBoolForDatePositionIMP, NO, calendar, date, monthPosition);
+}
+
+- (void)calendar:(MMCalendar *)calendar didDeselectDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    MMCalendarDelegationEntry *entry = MMCalendarDelegationEntryForSelector(_entries, _cmd);
+    if (entry && entry->implementation && entry->targetSelector != _cmd) {
+        // calendar:didDeselectDate:
+        id delegation = _delegation;
+        if (delegation) ((MMCalendarVoidForObjectIMP)entry->implementation)(delegation, entry->targetSelector, calendar, date);
+        return;
+    }
+    MMCalendarDelegationPerform(MMCalendarVoidForDatePositionIMP, calendar, date, monthPosition);
+}
+
+- (void)calendar:(MMCalendar *)calendar boundingRectWillChange:(CGRect)bounds animated:(BOOL)animated
+{
+    MMCalendarDelegationPerform(MMCalendarVoidForRectIMP, calendar, bounds, animated);
+}
+
+- (void)calendar:(MMCalendar *)calendar willDisplayCell:(MMCalendarCell *)cell forDate:(NSDate *)date atMonthPosition:(MMCalendarMonthPosition)monthPosition
+{
+    MMCalendarDelegationPerform(MMCalendarVoidForCellIMP, calendar, cell, date, monthPosition);
+}
+
+- (void)calendarCurrentPageDidChange:(MMCalendar *)calendar
+{
+    // calendarCurrentMonthDidChange: takes the same arguments
+    MMCalendarDelegationPerform(MMCalendarVoidIMP, calendar);
+}
+
+#pragma mark MMCalendarDelegateAppearance
+
+#define MMCalendarDelegationAppearance(TYPE, IMPTYPE, DEFAULT, NAME) \
+- (TYPE)calendar:(MMCalendar *)calendar appearance:(MMCalendarAppearance *)appearance NAME:(NSDate *)date \
+{ \
+    MMCalendarDelegationInvoke(IMPTYPE, DEFAULT, calendar, appearance, date); \
+}
+
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, fillDefaultColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, fillSelectionColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, titleDefaultColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, titleSelectionColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, subtitleDefaultColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, subtitleSelectionColorForDate)
+MMCalendarDelegationAppearance(NSArray *, MMCalendarAppearanceObjectIMP, nil, eventDefaultColorsForDate)
+MMCalendarDelegationAppearance(NSArray *, MMCalendarAppearanceObjectIMP, nil, eventSelectionColorsForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, borderDefaultColorForDate)
+MMCalendarDelegationAppearance(UIColor *, MMCalendarAppearanceObjectIMP, nil, borderSelectionColorForDate)
+MMCalendarDelegationAppearance(CGPoint, MMCalendarAppearancePointIMP, CGPointZero, titleOffsetForDate)
+MMCalendarDelegationAppearance(CGPoint, MMCalendarAppearancePointIMP, CGPointZero, subtitleOffsetForDate)
+MMCalendarDelegationAppearance(CGPoint, MMCalendarAppearancePointIMP, CGPointZero, imageOffsetForDate)
+MMCalendarDelegationAppearance(CGPoint, MMCalendarAppearancePointIMP, CGPointZero, eventOffsetForDate)
+MMCalendarDelegationAppearance(CGFloat, MMCalendarAppearanceFloatIMP, 0, borderRadiusForDate)
+
 @end
+
+#undef MMCalendarDelegationTableSize
+#undef MMCalendarDelegationInvoke
+#undef MMCalendarDelegationPerform
+#undef MMCalendarDelegationAppearance
@@ -72,6 +72,12 @@
 
 @end
 
+@interface MMCalendarDayContent (Dynamic)
+
+- (void)prepareForDate:(NSDate *)date;
+
+@end
+
 @interface MMCalendarCollectionViewLayout (Dynamic)
 
 @property (readonly, nonatomic) CGSize estimatedItemSize;
@@ -0,0 +1,103 @@
+//
+//  MMCalendarEventFile.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Read-only events memory mapped from a compact binary file, and the writer and CSV converter that make such files.
+//  This file only depends on Foundation.
+//
+
+#import <Foundation/Foundation.h>
+#import "MMCalendarDateEngine.h"
+#import "MMCalendarEventStore.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * File format, version 1. Every integer is little endian.
+ *
+ *   Header, headerSize bytes (32 in version 1)
+ *     char[4]   magic "MMCE"
+ *     uint16    version
+ *     uint16    headerSize, records start right after it
+ *     uint32    numberOfEvents
+ *     uint32    maximumLength, the most days covered by one event
+ *     int32     minimumDayNumber, the earliest first day
+ *     int32     maximumDayNumber, the latest last day
+ *     uint32[2] reserved, zero
+ *
+ *   numberOfEvents records of 12 bytes, sorted by first day, then by attribute
+ *     int32     firstDayNumber
+ *     int32     lastDayNumber, inclusive
+ *     uint16    attribute, the color index
+ *     uint16    reserved, zero
+ *
+ *   numberOfEvents int32, the last day numbers of the same records sorted on their own
+ *
+ * A reader skips header bytes it doesn't know, so later versions can grow the header without moving the records.
+ */
+
+FOUNDATION_EXPORT NSString * const MMCalendarEventFileErrorDomain;
+
+typedef NS_ENUM(NSInteger, MMCalendarEventFileError) {
+    MMCalendarEventFileErrorUnreadable = 1,     // The underlying error is in NSPOSIXErrorDomain
+    MMCalendarEventFileErrorInvalidFormat,
+    MMCalendarEventFileErrorUnsupportedVersion,
+    MMCalendarEventFileErrorInvalidRecord,      // A record or CSV line the format can't hold, see the description
+};
+
+/**
+ * One event as written to a file. Day numbers are days since 1970-01-01 and must fit in 32 bits.
+ */
+struct MMCalendarEventRecord {
+    MMCalendarDayNumber firstDayNumber;
+    MMCalendarDayNumber lastDayNumber;  // Inclusive
+    uint16_t attribute;                 // Index into the colors of the file
+};
+typedef struct MMCalendarEventRecord MMCalendarEventRecord;
+
+/**
+ * Answers from the mapped pages directly: counting the events on a day is two binary searches, nothing is copied or parsed on load.
+ * Listing the events on a day scans the records that start within maximumLength days before it, so a few very long events make it slower.
+ *
+ * The file is expected to come from the writer below and is not checked for order. Queries are thread safe, colors is not.
+ */
+@interface MMCalendarEventFile : NSObject <MMCalendarEventSource>
+
+@property (readonly, nonatomic) NSString *path;
+@property (readonly, nonatomic) NSUInteger version;
+@property (readonly, nonatomic) NSUInteger numberOfEvents;
+@property (readonly, nonatomic) NSUInteger maximumLength;
+@property (readonly, nonatomic) MMCalendarDayNumber minimumDayNumber;
+@property (readonly, nonatomic) MMCalendarDayNumber maximumDayNumber;
+@property (copy, nonatomic) NSArray *colors;
+
+/**
+ * Maps the file and checks its header and size. Returns nil and an error in MMCalendarEventFileErrorDomain if it can't be used.
+ */
+- (nullable instancetype)initWithPath:(NSString *)path error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Colors of the events with the earliest first day come first.
+ */
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Sorts the records and writes them atomically in the current version.
+ */
++ (BOOL)writeRecords:(const MMCalendarEventRecord *)records count:(NSUInteger)count toPath:(NSString *)path error:(NSError **)error;
+
+/**
+ * Converts lines of "first,last,attribute" with days as yyyy-MM-dd, for example "2026-10-17,2026-10-19,2".
+ * The attribute may be left out and defaults to 0. Blank lines and lines starting with # are skipped.
+ * Days are taken as they are written, with no time zone involved.
+ */
++ (BOOL)writeRecordsFromCSVString:(NSString *)string toPath:(NSString *)path error:(NSError **)error;
++ (BOOL)convertCSVAtPath:(NSString *)csvPath toPath:(NSString *)path error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,369 @@
+//
+//  MMCalendarEventFile.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarEventFile.h"
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+NSString * const MMCalendarEventFileErrorDomain = @"MMCalendarEventFileErrorDomain";
+
+#define MMCalendarEventFileVersion 1
+#define MMCalendarEventFileHeaderSize 32
+#define MMCalendarEventFileRecordSize 12
+
+#pragma mark - Private functinos
+
+// The mapping is only byte aligned for headers of other sizes, so every field is copied out
+static inline int32_t MMCalendarEventFileReadInt32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return (int32_t)NSSwapLittleIntToHost(value);
+}
+
+static inline uint16_t MMCalendarEventFileReadUInt16(const uint8_t *bytes)
+{
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return NSSwapLittleShortToHost(value);
+}
+
+static inline void MMCalendarEventFileAppendInt32(NSMutableData *data, int32_t value)
+{
+    uint32_t little = NSSwapHostIntToLittle((uint32_t)value);
+    [data appendBytes:&little length:sizeof(little)];
+}
+
+static inline void MMCalendarEventFileAppendUInt16(NSMutableData *data, uint16_t value)
+{
+    uint16_t little = NSSwapHostShortToLittle(value);
+    [data appendBytes:&little length:sizeof(little)];
+}
+
+static int MMCalendarEventFileCompareRecords(const void *a, const void *b)
+{
+    const MMCalendarEventRecord *x = a, *y = b;
+    if (x->firstDayNumber != y->firstDayNumber) return x->firstDayNumber < y->firstDayNumber ? -1 : 1;
+    if (x->attribute != y->attribute) return x->attribute < y->attribute ? -1 : 1;
+    return 0;
+}
+
+static int MMCalendarEventFileCompareDayNumbers(const void *a, const void *b)
+{
+    MMCalendarDayNumber x = *(const MMCalendarDayNumber *)a, y = *(const MMCalendarDayNumber *)b;
+    return x < y ? -1 : x > y;
+}
+
+// The number of records whose first day is before dayNumber, or on it too if inclusive
+static NSInteger MMCalendarEventFileFirstDayBound(const uint8_t *records, NSInteger count, MMCalendarDayNumber dayNumber, BOOL inclusive)
+{
+    NSInteger low = 0, high = count;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        MMCalendarDayNumber firstDayNumber = MMCalendarEventFileReadInt32(records + middle*MMCalendarEventFileRecordSize);
+        if (firstDayNumber < dayNumber || (inclusive && firstDayNumber == dayNumber)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// The number of last day numbers below dayNumber
+static NSInteger MMCalendarEventFileLastDayBound(const uint8_t *lastDayNumbers, NSInteger count, MMCalendarDayNumber dayNumber)
+{
+    NSInteger low = 0, high = count;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        if (MMCalendarEventFileReadInt32(lastDayNumbers + middle*4) < dayNumber) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static BOOL MMCalendarEventFileScanDay(NSScanner *scanner, MMCalendarDayNumber *dayNumber)
+{
+    NSInteger year, month, day;
+    if (![scanner scanInteger:&year] || ![scanner scanString:@"-" intoString:NULL] ||
+        ![scanner scanInteger:&month] || ![scanner scanString:@"-" intoString:NULL] ||
+        ![scanner scanInteger:&day]) {
+        return NO;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > MMCalendarGregorianNumberOfDaysInMonth(year, month)) return NO;
+    *dayNumber = MMCalendarGregorianDayNumberFromCivil(year, month, day);
+    return YES;
+}
+
+static NSError *MMCalendarEventFileError(MMCalendarEventFileError code, NSString *description, NSError *underlyingError)
+{
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey];
+    if (underlyingError) {
+        userInfo[NSUnderlyingErrorKey] = underlyingError;
+    }
+    return [NSError errorWithDomain:MMCalendarEventFileErrorDomain code:code userInfo:userInfo];
+}
+
+@interface MMCalendarEventFile ()
+
+@property (assign, nonatomic) const uint8_t *bytes;
+@property (assign, nonatomic) size_t length;
+
+// Both point into the mapping
+@property (assign, nonatomic) const uint8_t *records;
+@property (assign, nonatomic) const uint8_t *lastDayNumbers;
+
+- (BOOL)mapFileReturningError:(NSError **)error;
+- (BOOL)readHeaderReturningError:(NSError **)error;
+
+@end
+
+@implementation MMCalendarEventFile
+
+- (instancetype)initWithPath:(NSString *)path error:(NSError **)error
+{
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _colors = @[];
+        if (![self mapFileReturningError:error] || ![self readHeaderReturningError:error]) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_bytes) {
+        munmap((void *)_bytes, _length);
+    }
+}
+
+#pragma mark - Queries
+
+- (NSInteger)numberOfEventsForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    // Started on or before the day, minus ended before it
+    NSInteger count = self.numberOfEvents;
+    NSInteger started = MMCalendarEventFileFirstDayBound(self.records, count, dayNumber, YES);
+    NSInteger ended = MMCalendarEventFileLastDayBound(self.lastDayNumbers, count, dayNumber);
+    return started - ended;
+}
+
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    if (!maximumCount || !self.numberOfEvents) return 0;
+    NSInteger count = self.numberOfEvents;
+    // No event starting before the window is long enough to reach the day
+    NSInteger index = MMCalendarEventFileFirstDayBound(self.records, count, dayNumber - (NSInteger)self.maximumLength + 1, NO);
+    NSInteger limit = MMCalendarEventFileFirstDayBound(self.records, count, dayNumber, YES);
+    NSUInteger numberOfColors = 0;
+    for (; index < limit && numberOfColors < maximumCount; index++) {
+        const uint8_t *record = self.records + index*MMCalendarEventFileRecordSize;
+        if (MMCalendarEventFileReadInt32(record + 4) >= dayNumber) {
+            colorIndexes[numberOfColors++] = MMCalendarEventFileReadUInt16(record + 8);
+        }
+    }
+    return numberOfColors;
+}
+
+- (void)getNumberOfEvents:(NSInteger *)numbers fromDayNumber:(MMCalendarDayNumber)firstDayNumber count:(NSInteger)count
+{
+    if (count <= 0) return;
+    NSInteger numberOfEvents = self.numberOfEvents;
+    NSInteger index = MMCalendarEventFileFirstDayBound(self.records, numberOfEvents, firstDayNumber - (NSInteger)self.maximumLength + 1, NO);
+    NSInteger limit = MMCalendarEventFileFirstDayBound(self.records, numberOfEvents, firstDayNumber + count - 1, YES);
+    NSInteger *differences = calloc(count+1, sizeof(NSInteger));
+    for (; index < limit; index++) {
+        const uint8_t *record = self.records + index*MMCalendarEventFileRecordSize;
+        NSInteger first = MMCalendarEventFileReadInt32(record) - firstDayNumber;
+        NSInteger last = MMCalendarEventFileReadInt32(record + 4) - firstDayNumber;
+        // Order isn't checked, a record out of place or ending before it starts must not reach outside the window
+        if (last < 0 || first >= count || last < first) continue;
+        differences[MAX(first, 0)]++;
+        differences[MIN(last, count-1)+1]--;
+    }
+    NSInteger number = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        number += differences[i];
+        numbers[i] = number;
+    }
+    free(differences);
+}
+
+#pragma mark - Writing
+
++ (BOOL)writeRecords:(const MMCalendarEventRecord *)records count:(NSUInteger)count toPath:(NSString *)path error:(NSError **)error
+{
+    if (count > UINT32_MAX) {
+        if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidRecord, @"Too many events for one file.", nil);
+        return NO;
+    }
+    for (NSUInteger i = 0; i < count; i++) {
+        MMCalendarEventRecord record = records[i];
+        if (record.firstDayNumber < INT32_MIN || record.lastDayNumber > INT32_MAX || record.lastDayNumber < record.firstDayNumber) {
+            if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidRecord, [NSString stringWithFormat:@"Event %lu ends before it starts or is out of range.", (unsigned long)i], nil);
+            return NO;
+        }
+    }
+
+    MMCalendarEventRecord *sorted = malloc(MAX(count, 1)*sizeof(MMCalendarEventRecord));
+    MMCalendarDayNumber *lastDayNumbers = malloc(MAX(count, 1)*sizeof(MMCalendarDayNumber));
+    memcpy(sorted, records, count*sizeof(MMCalendarEventRecord));
+    qsort(sorted, count, sizeof(MMCalendarEventRecord), MMCalendarEventFileCompareRecords);
+    NSInteger maximumLength = 0;
+    MMCalendarDayNumber minimumDayNumber = count ? sorted[0].firstDayNumber : 0;
+    MMCalendarDayNumber maximumDayNumber = count ? sorted[0].lastDayNumber : 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        lastDayNumbers[i] = sorted[i].lastDayNumber;
+        maximumLength = MAX(maximumLength, sorted[i].lastDayNumber - sorted[i].firstDayNumber + 1);
+        maximumDayNumber = MAX(maximumDayNumber, sorted[i].lastDayNumber);
+    }
+    qsort(lastDayNumbers, count, sizeof(MMCalendarDayNumber), MMCalendarEventFileCompareDayNumbers);
+
+    NSMutableData *data = [NSMutableData dataWithCapacity:MMCalendarEventFileHeaderSize + count*(MMCalendarEventFileRecordSize+4)];
+    [data appendBytes:"MMCE" length:4];
+    MMCalendarEventFileAppendUInt16(data, MMCalendarEventFileVersion);
+    MMCalendarEventFileAppendUInt16(data, MMCalendarEventFileHeaderSize);
+    MMCalendarEventFileAppendInt32(data, (int32_t)count);
+    MMCalendarEventFileAppendInt32(data, (int32_t)MIN(maximumLength, INT32_MAX));
+    MMCalendarEventFileAppendInt32(data, (int32_t)minimumDayNumber);
+    MMCalendarEventFileAppendInt32(data, (int32_t)maximumDayNumber);
+    MMCalendarEventFileAppendInt32(data, 0);
+    MMCalendarEventFileAppendInt32(data, 0);
+    for (NSUInteger i = 0; i < count; i++) {
+        MMCalendarEventFileAppendInt32(data, (int32_t)sorted[i].firstDayNumber);
+        MMCalendarEventFileAppendInt32(data, (int32_t)sorted[i].lastDayNumber);
+        MMCalendarEventFileAppendUInt16(data, sorted[i].attribute);
+        MMCalendarEventFileAppendUInt16(data, 0);
+    }
+    for (NSUInteger i = 0; i < count; i++) {
+        MMCalendarEventFileAppendInt32(data, (int32_t)lastDayNumbers[i]);
+    }
+    free(sorted);
+    free(lastDayNumbers);
+    return [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
++ (BOOL)writeRecordsFromCSVString:(NSString *)string toPath:(NSString *)path error:(NSError **)error
+{
+    NSMutableData *records = [NSMutableData data];
+    __block NSError *lineError = nil;
+    __block NSUInteger lineNumber = 0;
+    [string enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+        lineNumber++;
+        line = [line stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if (!line.length || [line hasPrefix:@"#"]) return;
+        NSScanner *scanner = [NSScanner scannerWithString:line];
+        scanner.charactersToBeSkipped = [NSCharacterSet whitespaceCharacterSet];
+        MMCalendarEventRecord record = {0};
+        NSInteger attribute = 0;
+        BOOL valid = MMCalendarEventFileScanDay(scanner, &record.firstDayNumber) &&
+                     [scanner scanString:@"," intoString:NULL] &&
+                     MMCalendarEventFileScanDay(scanner, &record.lastDayNumber) &&
+                     (![scanner scanString:@"," intoString:NULL] || [scanner scanInteger:&attribute]) &&
+                     scanner.isAtEnd &&
+                     attribute >= 0 && attribute <= UINT16_MAX &&
+                     record.lastDayNumber >= record.firstDayNumber;
+        if (!valid) {
+            lineError = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidRecord, [NSString stringWithFormat:@"Line %lu is not \"yyyy-MM-dd,yyyy-MM-dd,attribute\" with the last day on or after the first.", (unsigned long)lineNumber], nil);
+            *stop = YES;
+            return;
+        }
+        record.attribute = (uint16_t)attribute;
+        [records appendBytes:&record length:sizeof(record)];
+    }];
+    if (lineError) {
+        if (error) *error = lineError;
+        return NO;
+    }
+    return [self writeRecords:records.bytes count:records.length/sizeof(MMCalendarEventRecord) toPath:path error:error];
+}
+
++ (BOOL)convertCSVAtPath:(NSString *)csvPath toPath:(NSString *)path error:(NSError **)error
+{
+    NSString *string = [NSString stringWithContentsOfFile:csvPath encoding:NSUTF8StringEncoding error:error];
+    if (!string) return NO;
+    return [self writeRecordsFromCSVString:string toPath:path error:error];
+}
+
+#pragma mark - Private methods
+
+- (BOOL)mapFileReturningError:(NSError **)error
+{
+    int descriptor = open(self.path.fileSystemRepresentation, O_RDONLY);
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) != 0) {
+        if (error) {
+            NSError *posixError = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+            *error = MMCalendarEventFileError(MMCalendarEventFileErrorUnreadable, [NSString stringWithFormat:@"Can't open %@.", self.path], posixError);
+        }
+        if (descriptor >= 0) close(descriptor);
+        return NO;
+    }
+    if (status.st_size < MMCalendarEventFileHeaderSize) {
+        close(descriptor);
+        if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidFormat, @"The file is shorter than a header.", nil);
+        return NO;
+    }
+    void *bytes = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // The mapping keeps the file alive on its own
+    int mapError = errno;
+    close(descriptor);
+    if (bytes == MAP_FAILED) {
+        if (error) {
+            NSError *posixError = [NSError errorWithDomain:NSPOSIXErrorDomain code:mapError userInfo:nil];
+            *error = MMCalendarEventFileError(MMCalendarEventFileErrorUnreadable, [NSString stringWithFormat:@"Can't map %@.", self.path], posixError);
+        }
+        return NO;
+    }
+    self.bytes = bytes;
+    self.length = (size_t)status.st_size;
+    return YES;
+}
+
+- (BOOL)readHeaderReturningError:(NSError **)error
+{
+    const uint8_t *bytes = self.bytes;
+    if (memcmp(bytes, "MMCE", 4) != 0) {
+        if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidFormat, @"The file is not an event file.", nil);
+        return NO;
+    }
+    _version = MMCalendarEventFileReadUInt16(bytes + 4);
+    if (_version != MMCalendarEventFileVersion) {
+        if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorUnsupportedVersion, [NSString stringWithFormat:@"Version %lu is not supported.", (unsigned long)_version], nil);
+        return NO;
+    }
+    uint64_t headerSize = MMCalendarEventFileReadUInt16(bytes + 6);
+    uint64_t numberOfEvents = (uint32_t)MMCalendarEventFileReadInt32(bytes + 8);
+    int32_t maximumLength = MMCalendarEventFileReadInt32(bytes + 12);
+    if (headerSize < MMCalendarEventFileHeaderSize || maximumLength < 0 ||
+        headerSize + numberOfEvents*(MMCalendarEventFileRecordSize+4) > self.length) {
+        if (error) *error = MMCalendarEventFileError(MMCalendarEventFileErrorInvalidFormat, @"The header doesn't match the size of the file.", nil);
+        return NO;
+    }
+    _numberOfEvents = (NSUInteger)numberOfEvents;
+    _maximumLength = (NSUInteger)maximumLength;
+    _minimumDayNumber = MMCalendarEventFileReadInt32(bytes + 16);
+    _maximumDayNumber = MMCalendarEventFileReadInt32(bytes + 20);
+    self.records = bytes + headerSize;
+    self.lastDayNumbers = self.records + numberOfEvents*MMCalendarEventFileRecordSize;
+    return YES;
+}
+
+@end
+
+#undef MMCalendarEventFileVersion
+#undef MMCalendarEventFileHeaderSize
+#undef MMCalendarEventFileRecordSize
@@ -0,0 +1,101 @@
+//
+//  MMCalendarEventStore.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Events indexed by day number, for calendars whose event dots come from a large set of timed events.
+//  This file only depends on Foundation.
+//
+
+#import <Foundation/Foundation.h>
+#import "MMCalendarDateEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * One event as handed to the store. Times are seconds since 1970, as in -[NSDate timeIntervalSince1970].
+ */
+struct MMCalendarEvent {
+    NSTimeInterval startTime;
+    NSTimeInterval endTime;  // Exclusive, an event ending at midnight doesn't show on the next day
+    uint64_t identifier;     // Tells apart events starting on the same day when removing them
+    uint32_t colorIndex;     // Index into the colors of the store
+};
+typedef struct MMCalendarEvent MMCalendarEvent;
+
+/**
+ * Posted after the events of a store change. The day number keys are left out when every day may have changed.
+ */
+FOUNDATION_EXPORT NSNotificationName const MMCalendarEventStoreDidChangeNotification;
+FOUNDATION_EXPORT NSString * const MMCalendarEventStoreFirstDayNumberKey;
+FOUNDATION_EXPORT NSString * const MMCalendarEventStoreLastDayNumberKey;
+
+/**
+ * What the calendar asks about the events of a day. Adopted by MMCalendarEventStore, MMCalendarEventFile and MMCalendarRecurringEventSource.
+ */
+@protocol MMCalendarEventSource <NSObject>
+
+/**
+ * Looked up by color index, modulo the number of colors. UIColor objects for MMCalendar.
+ */
+@property (readonly, nonatomic) NSArray *colors;
+
+- (NSInteger)numberOfEventsForDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Writes the color indexes of up to maximumCount events on the day and returns how many were written.
+ */
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Counts the events on count consecutive days in one pass over the events overlapping them.
+ */
+- (void)getNumberOfEvents:(NSInteger *)numbers fromDayNumber:(MMCalendarDayNumber)firstDayNumber count:(NSInteger)count;
+
+@end
+
+/**
+ * Keeps events sorted by first day next to a tree of the latest last day under every node, so the events on a day are found without looking at the ones that ended before.
+ * Counting the events on a day takes two binary searches, listing them is logarithmic per event. Adding or removing an event shifts the arrays in place, nothing is sorted again.
+ *
+ * Not thread safe, change and query a store on the main thread.
+ */
+@interface MMCalendarEventStore : NSObject <MMCalendarEventSource>
+
+/**
+ * Days start at midnight in this time zone. Use the time zone of the calendar, which is the local one.
+ */
+@property (readonly, nonatomic) NSTimeZone *timeZone;
+@property (readonly, nonatomic) MMCalendarDateEngine *engine;
+
+@property (readonly, nonatomic) NSUInteger numberOfEvents;
+@property (copy, nonatomic) NSArray *colors;
+
+/**
+ * Creates a store in the local time zone.
+ */
+- (instancetype)init;
+- (instancetype)initWithTimeZone:(NSTimeZone *)timeZone NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Replaces every event of the store.
+ */
+- (void)loadEvents:(const MMCalendarEvent *)events count:(NSUInteger)count;
+- (void)addEvent:(MMCalendarEvent)event;
+
+/**
+ * Removes the event starting on the same day with the same identifier. Returns NO if there is none.
+ */
+- (BOOL)removeEvent:(MMCalendarEvent)event;
+- (void)removeAllEvents;
+
+/**
+ * Colors of the events with the earliest first day come first.
+ */
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,336 @@
+//
+//  MMCalendarEventStore.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarEventStore.h"
+
+NSNotificationName const MMCalendarEventStoreDidChangeNotification = @"MMCalendarEventStoreDidChangeNotification";
+NSString * const MMCalendarEventStoreFirstDayNumberKey = @"MMCalendarEventStoreFirstDayNumberKey";
+NSString * const MMCalendarEventStoreLastDayNumberKey = @"MMCalendarEventStoreLastDayNumberKey";
+
+// Deep enough for a tree over every index, a node pushes at most two children per level
+#define MMCalendarEventStoreStackSize 128
+
+typedef struct MMCalendarEventStoreEntry {
+    MMCalendarDayNumber firstDayNumber;
+    MMCalendarDayNumber lastDayNumber;
+    uint64_t identifier;
+    uint32_t colorIndex;
+} MMCalendarEventStoreEntry;
+
+// Returns NO to stop visiting
+typedef BOOL (*MMCalendarEventStoreVisitor)(const MMCalendarEventStoreEntry *entry, void *context);
+
+#pragma mark - Private functinos
+
+static int MMCalendarEventStoreCompareEntries(const void *a, const void *b)
+{
+    const MMCalendarEventStoreEntry *x = a, *y = b;
+    if (x->firstDayNumber != y->firstDayNumber) return x->firstDayNumber < y->firstDayNumber ? -1 : 1;
+    if (x->identifier != y->identifier) return x->identifier < y->identifier ? -1 : 1;
+    return 0;
+}
+
+static int MMCalendarEventStoreCompareDayNumbers(const void *a, const void *b)
+{
+    MMCalendarDayNumber x = *(const MMCalendarDayNumber *)a, y = *(const MMCalendarDayNumber *)b;
+    return x < y ? -1 : x > y;
+}
+
+// The number of entries before the first one that sorts after (dayNumber, identifier)
+static NSInteger MMCalendarEventStoreUpperBound(const MMCalendarEventStoreEntry *entries, NSInteger count, MMCalendarDayNumber dayNumber, uint64_t identifier)
+{
+    NSInteger low = 0, high = count;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        const MMCalendarEventStoreEntry *entry = entries + middle;
+        if (entry->firstDayNumber < dayNumber || (entry->firstDayNumber == dayNumber && entry->identifier <= identifier)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// The number of day numbers below dayNumber
+static NSInteger MMCalendarEventStoreLowerBound(const MMCalendarDayNumber *dayNumbers, NSInteger count, MMCalendarDayNumber dayNumber)
+{
+    NSInteger low = 0, high = count;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        if (dayNumbers[middle] < dayNumber) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/*
+ * Visits the first `limit` entries whose last day is on or after dayNumber, in order.
+ * Node 1 is the root, node n has children 2n and 2n+1 and leaf l is node numberOfLeaves+l. A subtree ending before dayNumber is skipped as a whole.
+ */
+static void MMCalendarEventStoreVisit(const MMCalendarEventStoreEntry *entries, const MMCalendarDayNumber *tree, NSInteger numberOfLeaves, NSInteger limit, MMCalendarDayNumber dayNumber, MMCalendarEventStoreVisitor visitor, void *context)
+{
+    if (!limit) return;
+    NSInteger stack[MMCalendarEventStoreStackSize];
+    NSInteger depth = 0;
+    stack[depth++] = 1;
+    while (depth) {
+        NSInteger node = stack[--depth];
+        if (tree[node] < dayNumber) continue;
+        // The first leaf under the node
+        NSInteger level = 0;
+        for (NSInteger n = node; n < numberOfLeaves; n <<= 1) level++;
+        if ((node << level) - numberOfLeaves >= limit) continue;
+        if (node >= numberOfLeaves) {
+            if (!visitor(entries + node - numberOfLeaves, context)) return;
+            continue;
+        }
+        stack[depth++] = 2*node+1;
+        stack[depth++] = 2*node;
+    }
+}
+
+typedef struct MMCalendarEventStoreColorContext {
+    uint32_t *colorIndexes;
+    NSUInteger count;
+    NSUInteger maximumCount;
+} MMCalendarEventStoreColorContext;
+
+static BOOL MMCalendarEventStoreCollectColor(const MMCalendarEventStoreEntry *entry, void *context)
+{
+    MMCalendarEventStoreColorContext *colors = context;
+    colors->colorIndexes[colors->count++] = entry->colorIndex;
+    return colors->count < colors->maximumCount;
+}
+
+typedef struct MMCalendarEventStoreCountContext {
+    NSInteger *numbers; // count+1 differences, summed up afterwards
+    MMCalendarDayNumber firstDayNumber;
+    NSInteger count;
+} MMCalendarEventStoreCountContext;
+
+static BOOL MMCalendarEventStoreCountDays(const MMCalendarEventStoreEntry *entry, void *context)
+{
+    MMCalendarEventStoreCountContext *counts = context;
+    NSInteger first = MAX(entry->firstDayNumber - counts->firstDayNumber, 0);
+    NSInteger last = MIN(entry->lastDayNumber - counts->firstDayNumber, counts->count-1);
+    counts->numbers[first]++;
+    counts->numbers[last+1]--;
+    return YES;
+}
+
+@interface MMCalendarEventStore ()
+
+// Sorted by first day, then by identifier
+@property (assign, nonatomic) MMCalendarEventStoreEntry *entries;
+// The last days of the same events, sorted on their own
+@property (assign, nonatomic) MMCalendarDayNumber *lastDayNumbers;
+@property (assign, nonatomic) NSInteger capacity;
+
+// The latest last day under every node, see MMCalendarEventStoreVisit
+@property (assign, nonatomic) MMCalendarDayNumber *tree;
+@property (assign, nonatomic) NSInteger numberOfLeaves;
+
+@property (assign, nonatomic) NSUInteger numberOfEvents;
+
+- (MMCalendarEventStoreEntry)entryForEvent:(MMCalendarEvent)event;
+- (void)reserveCapacity:(NSInteger)capacity;
+- (void)rebuildTreeFromIndex:(NSInteger)index;
+- (void)postChangeFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber;
+
+@end
+
+@implementation MMCalendarEventStore
+
+- (instancetype)init
+{
+    return [self initWithTimeZone:[NSTimeZone localTimeZone]];
+}
+
+- (instancetype)initWithTimeZone:(NSTimeZone *)timeZone
+{
+    self = [super init];
+    if (self) {
+        _timeZone = timeZone;
+        NSCalendar *gregorian = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+        gregorian.timeZone = timeZone;
+        _engine = [[MMCalendarDateEngine alloc] initWithCalendar:gregorian minimumDate:nil];
+        _colors = @[];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_entries);
+    free(_lastDayNumbers);
+    free(_tree);
+}
+
+#pragma mark - Changes
+
+- (void)loadEvents:(const MMCalendarEvent *)events count:(NSUInteger)count
+{
+    [self reserveCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        self.entries[i] = [self entryForEvent:events[i]];
+        self.lastDayNumbers[i] = self.entries[i].lastDayNumber;
+    }
+    qsort(self.entries, count, sizeof(MMCalendarEventStoreEntry), MMCalendarEventStoreCompareEntries);
+    qsort(self.lastDayNumbers, count, sizeof(MMCalendarDayNumber), MMCalendarEventStoreCompareDayNumbers);
+    self.numberOfEvents = count;
+    [self rebuildTreeFromIndex:0];
+    [[NSNotificationCenter defaultCenter] postNotificationName:MMCalendarEventStoreDidChangeNotification object:self];
+}
+
+- (void)addEvent:(MMCalendarEvent)event
+{
+    MMCalendarEventStoreEntry entry = [self entryForEvent:event];
+    NSInteger count = self.numberOfEvents;
+    [self reserveCapacity:count+1];
+
+    NSInteger index = MMCalendarEventStoreUpperBound(self.entries, count, entry.firstDayNumber, entry.identifier);
+    memmove(self.entries+index+1, self.entries+index, (count-index)*sizeof(MMCalendarEventStoreEntry));
+    self.entries[index] = entry;
+
+    NSInteger lastIndex = MMCalendarEventStoreLowerBound(self.lastDayNumbers, count, entry.lastDayNumber);
+    memmove(self.lastDayNumbers+lastIndex+1, self.lastDayNumbers+lastIndex, (count-lastIndex)*sizeof(MMCalendarDayNumber));
+    self.lastDayNumbers[lastIndex] = entry.lastDayNumber;
+
+    self.numberOfEvents = count+1;
+    [self rebuildTreeFromIndex:index];
+    [self postChangeFromDayNumber:entry.firstDayNumber toDayNumber:entry.lastDayNumber];
+}
+
+- (BOOL)removeEvent:(MMCalendarEvent)event
+{
+    MMCalendarEventStoreEntry target = [self entryForEvent:event];
+    NSInteger count = self.numberOfEvents;
+    NSInteger index = MMCalendarEventStoreUpperBound(self.entries, count, target.firstDayNumber, target.identifier) - 1;
+    if (index < 0 || MMCalendarEventStoreCompareEntries(self.entries+index, &target) != 0) {
+        return NO;
+    }
+    // The stored entry knows the last day, the event may have been changed since it was added
+    MMCalendarEventStoreEntry entry = self.entries[index];
+    memmove(self.entries+index, self.entries+index+1, (count-index-1)*sizeof(MMCalendarEventStoreEntry));
+
+    NSInteger lastIndex = MMCalendarEventStoreLowerBound(self.lastDayNumbers, count, entry.lastDayNumber);
+    memmove(self.lastDayNumbers+lastIndex, self.lastDayNumbers+lastIndex+1, (count-lastIndex-1)*sizeof(MMCalendarDayNumber));
+
+    self.numberOfEvents = count-1;
+    [self rebuildTreeFromIndex:index];
+    [self postChangeFromDayNumber:entry.firstDayNumber toDayNumber:entry.lastDayNumber];
+    return YES;
+}
+
+- (void)removeAllEvents
+{
+    self.numberOfEvents = 0;
+    [self rebuildTreeFromIndex:0];
+    [[NSNotificationCenter defaultCenter] postNotificationName:MMCalendarEventStoreDidChangeNotification object:self];
+}
+
+#pragma mark - Queries
+
+- (NSInteger)numberOfEventsForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    // Started on or before the day, minus ended before it
+    NSInteger count = self.numberOfEvents;
+    NSInteger started = MMCalendarEventStoreUpperBound(self.entries, count, dayNumber, UINT64_MAX);
+    NSInteger ended = MMCalendarEventStoreLowerBound(self.lastDayNumbers, count, dayNumber);
+    return started - ended;
+}
+
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    if (!maximumCount) return 0;
+    NSInteger limit = MMCalendarEventStoreUpperBound(self.entries, self.numberOfEvents, dayNumber, UINT64_MAX);
+    MMCalendarEventStoreColorContext context = {colorIndexes, 0, maximumCount};
+    MMCalendarEventStoreVisit(self.entries, self.tree, self.numberOfLeaves, limit, dayNumber, MMCalendarEventStoreCollectColor, &context);
+    return context.count;
+}
+
+- (void)getNumberOfEvents:(NSInteger *)numbers fromDayNumber:(MMCalendarDayNumber)firstDayNumber count:(NSInteger)count
+{
+    if (count <= 0) return;
+    NSInteger *differences = calloc(count+1, sizeof(NSInteger));
+    NSInteger limit = MMCalendarEventStoreUpperBound(self.entries, self.numberOfEvents, firstDayNumber+count-1, UINT64_MAX);
+    MMCalendarEventStoreCountContext context = {differences, firstDayNumber, count};
+    MMCalendarEventStoreVisit(self.entries, self.tree, self.numberOfLeaves, limit, firstDayNumber, MMCalendarEventStoreCountDays, &context);
+    NSInteger number = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        number += differences[i];
+        numbers[i] = number;
+    }
+    free(differences);
+}
+
+#pragma mark - Private methods
+
+- (MMCalendarEventStoreEntry)entryForEvent:(MMCalendarEvent)event
+{
+    MMCalendarEventStoreEntry entry;
+    entry.firstDayNumber = [self.engine dayNumberForDate:[NSDate dateWithTimeIntervalSince1970:event.startTime]];
+    entry.lastDayNumber = entry.firstDayNumber;
+    if (event.endTime > event.startTime) {
+        // The day the end falls on, or the one before if it ends right at midnight
+        NSDate *end = [NSDate dateWithTimeIntervalSince1970:event.endTime];
+        MMCalendarDayNumber endDayNumber = [self.engine dayNumberForDate:end];
+        if ([[self.engine dateForDayNumber:endDayNumber] isEqualToDate:end]) {
+            endDayNumber--;
+        }
+        entry.lastDayNumber = MAX(endDayNumber, entry.firstDayNumber);
+    }
+    entry.identifier = event.identifier;
+    entry.colorIndex = event.colorIndex;
+    return entry;
+}
+
+- (void)reserveCapacity:(NSInteger)capacity
+{
+    if (capacity <= self.capacity) return;
+    capacity = MAX(capacity, self.capacity*2);
+    self.entries = realloc(self.entries, capacity*sizeof(MMCalendarEventStoreEntry));
+    self.lastDayNumbers = realloc(self.lastDayNumbers, capacity*sizeof(MMCalendarDayNumber));
+    self.capacity = capacity;
+}
+
+- (void)rebuildTreeFromIndex:(NSInteger)index
+{
+    NSInteger count = self.numberOfEvents;
+    NSInteger numberOfLeaves = MAX(self.numberOfLeaves, 1);
+    while (numberOfLeaves < count) numberOfLeaves <<= 1;
+    if (numberOfLeaves != self.numberOfLeaves) {
+        free(self.tree);
+        self.tree = malloc(2*numberOfLeaves*sizeof(MMCalendarDayNumber));
+        self.numberOfLeaves = numberOfLeaves;
+        index = 0;
+    }
+    MMCalendarDayNumber *tree = self.tree;
+    // Leaves from the changed index on have shifted, including the one a removal left empty
+    for (NSInteger i = index; i < numberOfLeaves; i++) {
+        tree[numberOfLeaves+i] = i < count ? self.entries[i].lastDayNumber : NSIntegerMin;
+    }
+    for (NSInteger first = (numberOfLeaves+index)/2, last = (2*numberOfLeaves-1)/2; first >= 1; first /= 2, last /= 2) {
+        for (NSInteger node = first; node <= last; node++) {
+            tree[node] = MAX(tree[2*node], tree[2*node+1]);
+        }
+    }
+}
+
+- (void)postChangeFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber
+{
+    [[NSNotificationCenter defaultCenter] postNotificationName:MMCalendarEventStoreDidChangeNotification object:self userInfo:@{MMCalendarEventStoreFirstDayNumberKey: @(firstDayNumber), MMCalendarEventStoreLastDayNumberKey: @(lastDayNumber)}];
+}
+
+@end
+
+#undef MMCalendarEventStoreStackSize
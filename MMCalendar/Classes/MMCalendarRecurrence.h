@@ -0,0 +1,105 @@
+//
+//  MMCalendarRecurrence.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  RFC 5545 recurrence rules expanded on day numbers, and an event source that expands them only for the days on screen.
+//  This file only depends on Foundation.
+//
+
+#import <Foundation/Foundation.h>
+#import "MMCalendarDateEngine.h"
+#import "MMCalendarEventStore.h"
+#import "MMCalendarSelection.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const MMCalendarRecurrenceErrorDomain;
+
+typedef NS_ENUM(NSInteger, MMCalendarRecurrenceError) {
+    MMCalendarRecurrenceErrorInvalidRule = 1,
+    MMCalendarRecurrenceErrorUnsupportedRule,   // Valid, but with parts that don't resolve to whole days, like BYHOUR
+};
+
+typedef NS_ENUM(NSInteger, MMCalendarRecurrenceFrequency) {
+    MMCalendarRecurrenceFrequencyDaily,
+    MMCalendarRecurrenceFrequencyWeekly,
+    MMCalendarRecurrenceFrequencyMonthly,
+    MMCalendarRecurrenceFrequencyYearly
+};
+
+/**
+ * A recurring event: an RRULE value, the day of DTSTART and the days of EXDATE.
+ *
+ * Supports FREQ=DAILY, WEEKLY, MONTHLY and YEARLY with INTERVAL, COUNT, UNTIL, BYMONTH, BYMONTHDAY, BYDAY (with ordinals for MONTHLY and YEARLY), BYSETPOS and WKST.
+ * Days are proleptic Gregorian with no time zone, UNTIL only counts by its date. As in RFC 5545, the first day always occurs and counts towards COUNT.
+ *
+ * Any occurrence can be found without expanding the ones before it, except that a COUNT is turned into a last day once, on first use.
+ * Without BYxxx parts that last day is computed directly, with them the occurrences are counted, so COUNT is limited to 100000. INTERVAL is limited to 146097.
+ */
+@interface MMCalendarRecurrence : NSObject
+
+@property (readonly, nonatomic) NSString *rule;
+@property (readonly, nonatomic) MMCalendarDayNumber firstDayNumber;
+@property (readonly, nonatomic) MMCalendarRecurrenceFrequency frequency;
+@property (readonly, nonatomic) NSInteger interval;
+
+/**
+ * No occurrence starts after this day, from UNTIL or COUNT. NSIntegerMax for a rule that never ends.
+ */
+@property (readonly, nonatomic) MMCalendarDayNumber lastDayNumber;
+
+/**
+ * The number of days every occurrence covers, 1 by default.
+ */
+@property (assign, nonatomic) NSInteger numberOfDays;
+@property (assign, nonatomic) uint32_t colorIndex;
+
+/**
+ * EXDATE. Occurrences starting on these days are left out without changing how COUNT counts.
+ */
+@property (readonly, nonatomic) MMCalendarSelection *excludedDayNumbers;
+
+/**
+ * Parses an RRULE value, with or without the "RRULE:" prefix, for example "FREQ=MONTHLY;BYDAY=FR;BYSETPOS=-1".
+ */
+- (nullable instancetype)initWithRule:(NSString *)rule firstDayNumber:(MMCalendarDayNumber)firstDayNumber error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Enumerates the first days of the occurrences starting in a closed range, in ascending order.
+ */
+- (void)enumerateDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber usingBlock:(void (NS_NOESCAPE ^)(MMCalendarDayNumber dayNumber, BOOL *stop))block;
+
+@end
+
+/**
+ * Answers the calendar from recurrences. Occurrences are expanded per window of 64 days when a day in it is first asked for, and the last few windows are kept.
+ * The calendar only asks for the days of the pages it shows or prefetches, so memory follows the screen rather than how far the rules reach.
+ *
+ * Not thread safe, change and query a source on the main thread. A recurrence changed after being added is picked up by -invalidate.
+ */
+@interface MMCalendarRecurringEventSource : NSObject <MMCalendarEventSource>
+
+@property (readonly, nonatomic) NSArray<MMCalendarRecurrence *> *recurrences;
+@property (copy, nonatomic) NSArray *colors;
+
+- (void)addRecurrence:(MMCalendarRecurrence *)recurrence;
+- (void)removeRecurrence:(MMCalendarRecurrence *)recurrence;
+- (void)removeAllRecurrences;
+
+/**
+ * Drops every expanded window and posts MMCalendarEventStoreDidChangeNotification.
+ */
+- (void)invalidate;
+
+/**
+ * Colors of the occurrences with the earliest first day come first.
+ */
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,767 @@
+//
+//  MMCalendarRecurrence.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarRecurrence.h"
+
+NSString * const MMCalendarRecurrenceErrorDomain = @"MMCalendarRecurrenceErrorDomain";
+
+#define MMCalendarRecurrenceMaximumNumberOfOrdinalWeekdays 16
+#define MMCalendarRecurrenceMaximumNumberOfPositions 16
+
+// The Gregorian calendar repeats every 400 years, any rule that stays empty for that many days never occurs again
+#define MMCalendarRecurrenceMaximumEmptyDays 146097
+
+// Occurrences past this day are never visited, so stepping through periods can't overflow
+#define MMCalendarRecurrenceMaximumDayNumber (NSIntegerMax/4)
+// Rules with BYxxx parts count their occurrences one by one to find the last one
+#define MMCalendarRecurrenceMaximumCount 100000
+
+#define MMCalendarRecurrenceWindowSize 64
+#define MMCalendarRecurrenceNumberOfWindows 8
+
+typedef struct MMCalendarRecurrenceOrdinalWeekday {
+    int8_t ordinal;     // 1 for the first, -1 for the last
+    uint8_t weekday;    // 1 Sunday ... 7 Saturday, as in NSCalendar
+} MMCalendarRecurrenceOrdinalWeekday;
+
+typedef struct MMCalendarRecurrencePattern {
+    MMCalendarRecurrenceFrequency frequency;
+    NSInteger interval;
+    NSInteger count;                    // 0 if not limited by COUNT
+    MMCalendarDayNumber untilDayNumber; // NSIntegerMax if not limited by UNTIL
+    uint32_t months;                    // Bit m for month m
+    uint32_t monthDays;                 // Bit d for day d
+    uint32_t negativeMonthDays;         // Bit d for day -d, counted from the end of the month
+    uint32_t weekdays;                  // Bit w for weekday w on every week
+    NSInteger numberOfOrdinalWeekdays;
+    MMCalendarRecurrenceOrdinalWeekday ordinalWeekdays[MMCalendarRecurrenceMaximumNumberOfOrdinalWeekdays];
+    NSInteger numberOfPositions;
+    int16_t positions[MMCalendarRecurrenceMaximumNumberOfPositions];
+    NSInteger weekStart;
+    // Filled in from the first day where the rule leaves them out
+    NSInteger defaultMonth;
+    NSInteger defaultMonthDay;
+    NSInteger defaultWeekday;
+} MMCalendarRecurrencePattern;
+
+// Returns NO to stop expanding
+typedef BOOL (*MMCalendarRecurrenceVisitor)(MMCalendarDayNumber dayNumber, void *context);
+
+typedef struct MMCalendarRecurrenceOccurrence {
+    MMCalendarDayNumber firstDayNumber;
+    MMCalendarDayNumber lastDayNumber;
+    uint32_t colorIndex;
+} MMCalendarRecurrenceOccurrence;
+
+typedef struct MMCalendarRecurrenceWindow {
+    NSInteger index;            // NSIntegerMin while unused
+    NSUInteger lastAccess;
+    NSInteger numbers[MMCalendarRecurrenceWindowSize];
+    // Overlapping the window, sorted by first day
+    MMCalendarRecurrenceOccurrence *occurrences;
+    NSInteger numberOfOccurrences;
+    NSInteger capacity;
+} MMCalendarRecurrenceWindow;
+
+#pragma mark - Private functinos
+
+// 1970-01-01 was a Thursday
+static inline NSInteger MMCalendarRecurrenceWeekday(MMCalendarDayNumber dayNumber)
+{
+    return MMCalendarFloorModulo(dayNumber + 4, 7) + 1;
+}
+
+static inline BOOL MMCalendarRecurrenceIsLeapYear(NSInteger year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static inline BOOL MMCalendarRecurrenceMatchesMonthDay(const MMCalendarRecurrencePattern *pattern, NSInteger day, NSInteger numberOfDaysInMonth)
+{
+    return (pattern->monthDays >> day & 1) || (pattern->negativeMonthDays >> (numberOfDaysInMonth - day + 1) & 1);
+}
+
+// index is the position of the day in the month or year of length days that ordinals count in
+static BOOL MMCalendarRecurrenceMatchesWeekday(const MMCalendarRecurrencePattern *pattern, NSInteger weekday, NSInteger index, NSInteger length)
+{
+    if (pattern->weekdays >> weekday & 1) return YES;
+    for (NSInteger i = 0; i < pattern->numberOfOrdinalWeekdays; i++) {
+        MMCalendarRecurrenceOrdinalWeekday ordinalWeekday = pattern->ordinalWeekdays[i];
+        if (ordinalWeekday.weekday != weekday) continue;
+        NSInteger ordinal = ordinalWeekday.ordinal > 0 ? index / 7 + 1 : -((length - 1 - index) / 7 + 1);
+        if (ordinal == ordinalWeekday.ordinal) return YES;
+    }
+    return NO;
+}
+
+static inline BOOL MMCalendarRecurrenceHasWeekdays(const MMCalendarRecurrencePattern *pattern)
+{
+    return pattern->weekdays || pattern->numberOfOrdinalWeekdays;
+}
+
+static inline BOOL MMCalendarRecurrenceHasMonthDays(const MMCalendarRecurrencePattern *pattern)
+{
+    return pattern->monthDays || pattern->negativeMonthDays;
+}
+
+static inline BOOL MMCalendarRecurrenceHasParts(const MMCalendarRecurrencePattern *pattern)
+{
+    return pattern->months || MMCalendarRecurrenceHasMonthDays(pattern) || MMCalendarRecurrenceHasWeekdays(pattern) || pattern->numberOfPositions;
+}
+
+// Periods are numbered so that every INTERVAL-th one from the period of the first day recurs
+static NSInteger MMCalendarRecurrencePeriod(const MMCalendarRecurrencePattern *pattern, MMCalendarDayNumber dayNumber)
+{
+    NSInteger year, month;
+    switch (pattern->frequency) {
+        case MMCalendarRecurrenceFrequencyDaily:
+            return dayNumber;
+        case MMCalendarRecurrenceFrequencyWeekly:
+            // Day number weekStart-5 falls on the first day of a week
+            return MMCalendarFloorDivide(dayNumber - (pattern->weekStart - 5), 7);
+        case MMCalendarRecurrenceFrequencyMonthly:
+            MMCalendarGregorianCivilFromDayNumber(dayNumber, &year, &month, NULL);
+            return year * 12 + month - 1;
+        case MMCalendarRecurrenceFrequencyYearly:
+            MMCalendarGregorianCivilFromDayNumber(dayNumber, &year, NULL, NULL);
+            return year;
+    }
+    return 0;
+}
+
+// Enough periods to cover MMCalendarRecurrenceMaximumEmptyDays, counting each period at its shortest
+static NSInteger MMCalendarRecurrenceMaximumEmptyPeriods(const MMCalendarRecurrencePattern *pattern)
+{
+    NSInteger numberOfDays = 1;
+    switch (pattern->frequency) {
+        case MMCalendarRecurrenceFrequencyDaily:
+            numberOfDays = 1;
+            break;
+        case MMCalendarRecurrenceFrequencyWeekly:
+            numberOfDays = 7;
+            break;
+        case MMCalendarRecurrenceFrequencyMonthly:
+            numberOfDays = 28;
+            break;
+        case MMCalendarRecurrenceFrequencyYearly:
+            numberOfDays = 365;
+            break;
+    }
+    if (pattern->interval > MMCalendarRecurrenceMaximumEmptyDays / numberOfDays) return 1;
+    numberOfDays *= pattern->interval;
+    return (MMCalendarRecurrenceMaximumEmptyDays + numberOfDays - 1) / numberOfDays;
+}
+
+static MMCalendarDayNumber MMCalendarRecurrencePeriodStart(const MMCalendarRecurrencePattern *pattern, NSInteger period)
+{
+    switch (pattern->frequency) {
+        case MMCalendarRecurrenceFrequencyDaily:
+            return period;
+        case MMCalendarRecurrenceFrequencyWeekly:
+            return period * 7 + pattern->weekStart - 5;
+        case MMCalendarRecurrenceFrequencyMonthly:
+            return MMCalendarGregorianDayNumberFromCivil(MMCalendarFloorDivide(period, 12), MMCalendarFloorModulo(period, 12) + 1, 1);
+        case MMCalendarRecurrenceFrequencyYearly:
+            return MMCalendarGregorianDayNumberFromCivil(period, 1, 1);
+    }
+    return 0;
+}
+
+// Days of the months firstMonth...lastMonth of a year matching the BYxxx parts, with ordinals counted in the year or in each month
+static NSInteger MMCalendarRecurrenceGetMonthCandidates(const MMCalendarRecurrencePattern *pattern, NSInteger year, NSInteger firstMonth, NSInteger lastMonth, BOOL ordinalsInYear, MMCalendarDayNumber *dayNumbers)
+{
+    BOOL hasWeekdays = MMCalendarRecurrenceHasWeekdays(pattern);
+    BOOL hasMonthDays = MMCalendarRecurrenceHasMonthDays(pattern);
+    NSInteger numberOfDaysInYear = 365 + MMCalendarRecurrenceIsLeapYear(year);
+    NSInteger count = 0;
+    for (NSInteger month = firstMonth; month <= lastMonth; month++) {
+        if (pattern->months ? !(pattern->months >> month & 1) : (!hasWeekdays && !hasMonthDays && pattern->frequency == MMCalendarRecurrenceFrequencyYearly && month != pattern->defaultMonth)) {
+            continue;
+        }
+        MMCalendarDayNumber monthStart = MMCalendarGregorianDayNumberFromCivil(year, month, 1);
+        NSInteger numberOfDays = MMCalendarGregorianNumberOfDaysInMonth(year, month);
+        NSInteger dayOfYear = monthStart - MMCalendarGregorianDayNumberFromCivil(year, 1, 1);
+        NSInteger weekday = MMCalendarRecurrenceWeekday(monthStart);
+        for (NSInteger day = 1; day <= numberOfDays; day++, weekday = weekday % 7 + 1) {
+            if (hasMonthDays && !MMCalendarRecurrenceMatchesMonthDay(pattern, day, numberOfDays)) continue;
+            if (hasWeekdays) {
+                NSInteger index = ordinalsInYear ? dayOfYear + day - 1 : day - 1;
+                NSInteger length = ordinalsInYear ? numberOfDaysInYear : numberOfDays;
+                if (!MMCalendarRecurrenceMatchesWeekday(pattern, weekday, index, length)) continue;
+            }
+            if (!hasWeekdays && !hasMonthDays && day != pattern->defaultMonthDay) continue;
+            dayNumbers[count++] = monthStart + day - 1;
+        }
+    }
+    return count;
+}
+
+// The days of one period before BYSETPOS, ascending, 366 at most
+static NSInteger MMCalendarRecurrenceGetCandidates(const MMCalendarRecurrencePattern *pattern, NSInteger period, MMCalendarDayNumber *dayNumbers)
+{
+    NSInteger year, month, day;
+    switch (pattern->frequency) {
+        case MMCalendarRecurrenceFrequencyDaily: {
+            MMCalendarGregorianCivilFromDayNumber(period, &year, &month, &day);
+            if (pattern->months && !(pattern->months >> month & 1)) return 0;
+            if (MMCalendarRecurrenceHasMonthDays(pattern) && !MMCalendarRecurrenceMatchesMonthDay(pattern, day, MMCalendarGregorianNumberOfDaysInMonth(year, month))) return 0;
+            if (pattern->weekdays && !(pattern->weekdays >> MMCalendarRecurrenceWeekday(period) & 1)) return 0;
+            dayNumbers[0] = period;
+            return 1;
+        }
+        case MMCalendarRecurrenceFrequencyWeekly: {
+            MMCalendarDayNumber weekStart = MMCalendarRecurrencePeriodStart(pattern, period);
+            uint32_t weekdays = pattern->weekdays ?: 1u << pattern->defaultWeekday;
+            NSInteger count = 0;
+            for (MMCalendarDayNumber dayNumber = weekStart; dayNumber < weekStart + 7; dayNumber++) {
+                if (!(weekdays >> MMCalendarRecurrenceWeekday(dayNumber) & 1)) continue;
+                if (pattern->months) {
+                    MMCalendarGregorianCivilFromDayNumber(dayNumber, NULL, &month, NULL);
+                    if (!(pattern->months >> month & 1)) continue;
+                }
+                dayNumbers[count++] = dayNumber;
+            }
+            return count;
+        }
+        case MMCalendarRecurrenceFrequencyMonthly:
+            month = MMCalendarFloorModulo(period, 12) + 1;
+            return MMCalendarRecurrenceGetMonthCandidates(pattern, MMCalendarFloorDivide(period, 12), month, month, NO, dayNumbers);
+        case MMCalendarRecurrenceFrequencyYearly:
+            // Without BYMONTH, BYDAY ordinals count in the whole year
+            return MMCalendarRecurrenceGetMonthCandidates(pattern, period, 1, 12, !pattern->months, dayNumbers);
+    }
+    return 0;
+}
+
+static NSInteger MMCalendarRecurrenceApplyPositions(const MMCalendarRecurrencePattern *pattern, MMCalendarDayNumber *dayNumbers, NSInteger count)
+{
+    if (!pattern->numberOfPositions || !count) return count;
+    // Positions are few, so mark the picked candidates and compact in order
+    BOOL picked[366] = {NO};
+    for (NSInteger i = 0; i < pattern->numberOfPositions; i++) {
+        NSInteger position = pattern->positions[i];
+        NSInteger index = position > 0 ? position - 1 : count + position;
+        if (index >= 0 && index < count) picked[index] = YES;
+    }
+    NSInteger numberOfPicked = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        if (picked[i]) dayNumbers[numberOfPicked++] = dayNumbers[i];
+    }
+    return numberOfPicked;
+}
+
+/*
+ * Visits the occurrences starting between fromDayNumber and toDayNumber in order, the first day included.
+ * Starts at the first recurring period on or after fromDayNumber without going through the ones before. With maximumEmptyPeriods, gives up after that many periods in a row without an occurrence.
+ */
+static void MMCalendarRecurrenceExpand(const MMCalendarRecurrencePattern *pattern, MMCalendarDayNumber firstDayNumber, MMCalendarDayNumber fromDayNumber, MMCalendarDayNumber toDayNumber, NSInteger maximumEmptyPeriods, MMCalendarRecurrenceVisitor visitor, void *context)
+{
+    if (fromDayNumber <= firstDayNumber && firstDayNumber <= toDayNumber) {
+        if (!visitor(firstDayNumber, context)) return;
+    }
+    fromDayNumber = MAX(fromDayNumber, firstDayNumber + 1);
+    toDayNumber = MIN(toDayNumber, MMCalendarRecurrenceMaximumDayNumber);
+    if (fromDayNumber > toDayNumber) return;
+
+    NSInteger firstPeriod = MMCalendarRecurrencePeriod(pattern, firstDayNumber);
+    NSInteger skipped = MMCalendarRecurrencePeriod(pattern, fromDayNumber) - firstPeriod;
+    NSInteger period = firstPeriod - MMCalendarFloorDivide(-skipped, pattern->interval) * pattern->interval;
+    MMCalendarDayNumber dayNumbers[366];
+    NSInteger numberOfEmptyPeriods = 0;
+    for (; MMCalendarRecurrencePeriodStart(pattern, period) <= toDayNumber; period += pattern->interval) {
+        NSInteger count = MMCalendarRecurrenceGetCandidates(pattern, period, dayNumbers);
+        count = MMCalendarRecurrenceApplyPositions(pattern, dayNumbers, count);
+        if (!count) {
+            if (maximumEmptyPeriods && ++numberOfEmptyPeriods > maximumEmptyPeriods) return;
+            continue;
+        }
+        numberOfEmptyPeriods = 0;
+        for (NSInteger i = 0; i < count; i++) {
+            if (dayNumbers[i] < fromDayNumber) continue;
+            if (dayNumbers[i] > toDayNumber) return;
+            if (!visitor(dayNumbers[i], context)) return;
+        }
+    }
+}
+
+/*
+ * The day of occurrence n of a rule without BYxxx parts, 0 being the first day. Every period has its one occurrence but for months too short for the day of month.
+ * Stepping by INTERVAL comes back to the same period of the 400 year cycle after a few thousand steps at most, so only one round of steps is looked at.
+ */
+static MMCalendarDayNumber MMCalendarRecurrenceDayNumberOfOccurrence(const MMCalendarRecurrencePattern *pattern, MMCalendarDayNumber firstDayNumber, NSInteger n)
+{
+    NSInteger numberOfDaysInStep = 0;
+    NSInteger numberOfPeriodsInCycle = 0;
+    switch (pattern->frequency) {
+        case MMCalendarRecurrenceFrequencyDaily:
+            numberOfDaysInStep = pattern->interval;
+            break;
+        case MMCalendarRecurrenceFrequencyWeekly:
+            numberOfDaysInStep = pattern->interval * 7;
+            break;
+        case MMCalendarRecurrenceFrequencyMonthly:
+            numberOfPeriodsInCycle = 4800;
+            break;
+        case MMCalendarRecurrenceFrequencyYearly:
+            numberOfPeriodsInCycle = 400;
+            break;
+    }
+    NSInteger offset;
+    if (numberOfDaysInStep) {
+        if (__builtin_mul_overflow(n, numberOfDaysInStep, &offset) || offset > MMCalendarRecurrenceMaximumDayNumber - firstDayNumber) {
+            return MMCalendarRecurrenceMaximumDayNumber;
+        }
+        return firstDayNumber + offset;
+    }
+
+    NSInteger divisor = numberOfPeriodsInCycle;
+    for (NSInteger remainder = pattern->interval; remainder; ) {
+        NSInteger next = divisor % remainder;
+        divisor = remainder;
+        remainder = next;
+    }
+    // After numberOfSteps steps the periods are numberOfCycles whole cycles of 146097 days further
+    NSInteger numberOfSteps = numberOfPeriodsInCycle / divisor;
+    NSInteger numberOfCycles = pattern->interval / divisor;
+    NSInteger firstPeriod = MMCalendarRecurrencePeriod(pattern, firstDayNumber);
+    MMCalendarDayNumber dayNumbers[366];
+    NSInteger numberOfOccurrencesInSteps = 0;
+    for (NSInteger step = 0; step < numberOfSteps; step++) {
+        numberOfOccurrencesInSteps += MMCalendarRecurrenceGetCandidates(pattern, firstPeriod + step * pattern->interval, dayNumbers);
+    }
+    NSInteger remaining = n % numberOfOccurrencesInSteps;
+    MMCalendarDayNumber dayNumber = firstDayNumber;
+    for (NSInteger step = 0; step < numberOfSteps; step++) {
+        if (!MMCalendarRecurrenceGetCandidates(pattern, firstPeriod + step * pattern->interval, dayNumbers)) continue;
+        if (!remaining--) {
+            dayNumber = dayNumbers[0];
+            break;
+        }
+    }
+    if (__builtin_mul_overflow(n / numberOfOccurrencesInSteps, numberOfCycles * MMCalendarRecurrenceMaximumEmptyDays, &offset) || offset > MMCalendarRecurrenceMaximumDayNumber - dayNumber) {
+        return MMCalendarRecurrenceMaximumDayNumber;
+    }
+    return dayNumber + offset;
+}
+
+typedef struct MMCalendarRecurrenceCountContext {
+    NSInteger remaining;
+    MMCalendarDayNumber lastDayNumber;
+} MMCalendarRecurrenceCountContext;
+
+static BOOL MMCalendarRecurrenceCountOccurrence(MMCalendarDayNumber dayNumber, void *context)
+{
+    MMCalendarRecurrenceCountContext *counts = context;
+    counts->lastDayNumber = dayNumber;
+    return --counts->remaining > 0;
+}
+
+typedef struct MMCalendarRecurrenceBlockContext {
+    __unsafe_unretained MMCalendarSelection *excludedDayNumbers;
+    __unsafe_unretained void (^block)(MMCalendarDayNumber, BOOL *);
+    BOOL stop;
+} MMCalendarRecurrenceBlockContext;
+
+static BOOL MMCalendarRecurrenceCallBlock(MMCalendarDayNumber dayNumber, void *context)
+{
+    MMCalendarRecurrenceBlockContext *blocks = context;
+    if (blocks->excludedDayNumbers.count && [blocks->excludedDayNumbers containsDayNumber:dayNumber]) return YES;
+    blocks->block(dayNumber, &blocks->stop);
+    return !blocks->stop;
+}
+
+static int MMCalendarRecurrenceCompareOccurrences(const void *a, const void *b)
+{
+    const MMCalendarRecurrenceOccurrence *x = a, *y = b;
+    if (x->firstDayNumber != y->firstDayNumber) return x->firstDayNumber < y->firstDayNumber ? -1 : 1;
+    if (x->colorIndex != y->colorIndex) return x->colorIndex < y->colorIndex ? -1 : 1;
+    return 0;
+}
+
+static NSError *MMCalendarRecurrenceError(MMCalendarRecurrenceError code, NSString *description)
+{
+    return [NSError errorWithDomain:MMCalendarRecurrenceErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
+// MO is 2 as in NSCalendar, 0 if the name is unknown
+static NSInteger MMCalendarRecurrenceWeekdayForName(NSString *name)
+{
+    NSUInteger index = [@[@"SU", @"MO", @"TU", @"WE", @"TH", @"FR", @"SA"] indexOfObject:name];
+    return index == NSNotFound ? 0 : index + 1;
+}
+
+// Reads a comma separated list of integers in [minimum, maximum], zero excluded
+static BOOL MMCalendarRecurrenceScanIntegers(NSString *value, NSInteger minimum, NSInteger maximum, void (NS_NOESCAPE ^block)(NSInteger integer))
+{
+    for (NSString *item in [value componentsSeparatedByString:@","]) {
+        NSScanner *scanner = [NSScanner scannerWithString:item];
+        NSInteger integer;
+        if (![scanner scanInteger:&integer] || !scanner.isAtEnd || integer < minimum || integer > maximum || integer == 0) {
+            return NO;
+        }
+        block(integer);
+    }
+    return YES;
+}
+
+static NSError *MMCalendarRecurrenceParse(NSString *rule, MMCalendarDayNumber firstDayNumber, MMCalendarRecurrencePattern *pattern)
+{
+    memset(pattern, 0, sizeof(*pattern));
+    pattern->frequency = -1;
+    pattern->interval = 1;
+    pattern->untilDayNumber = NSIntegerMax;
+    pattern->weekStart = 2;
+    BOOL hasUntil = NO;
+
+    if ([rule hasPrefix:@"RRULE:"]) {
+        rule = [rule substringFromIndex:6];
+    }
+    for (NSString *part in [rule componentsSeparatedByString:@";"]) {
+        if (!part.length) continue;
+        NSRange equal = [part rangeOfString:@"="];
+        if (equal.location == NSNotFound) {
+            return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, [NSString stringWithFormat:@"\"%@\" is not NAME=VALUE.", part]);
+        }
+        NSString *name = [part substringToIndex:equal.location].uppercaseString;
+        NSString *value = [part substringFromIndex:NSMaxRange(equal)].uppercaseString;
+        __block BOOL valid = YES;
+        if ([name isEqualToString:@"FREQ"]) {
+            NSUInteger index = [@[@"DAILY", @"WEEKLY", @"MONTHLY", @"YEARLY"] indexOfObject:value];
+            if (index == NSNotFound) {
+                BOOL known = [@[@"SECONDLY", @"MINUTELY", @"HOURLY"] containsObject:value];
+                return MMCalendarRecurrenceError(known ? MMCalendarRecurrenceErrorUnsupportedRule : MMCalendarRecurrenceErrorInvalidRule, [NSString stringWithFormat:@"FREQ=%@ is not supported.", value]);
+            }
+            pattern->frequency = index;
+        } else if ([name isEqualToString:@"INTERVAL"]) {
+            // Longer intervals recur after every date NSCalendar handles
+            valid = MMCalendarRecurrenceScanIntegers(value, 1, MMCalendarRecurrenceMaximumEmptyDays, ^(NSInteger integer) {
+                pattern->interval = integer;
+            }) && ![value containsString:@","];
+        } else if ([name isEqualToString:@"COUNT"]) {
+            valid = MMCalendarRecurrenceScanIntegers(value, 1, NSIntegerMax, ^(NSInteger integer) {
+                pattern->count = integer;
+            }) && ![value containsString:@","];
+        } else if ([name isEqualToString:@"UNTIL"]) {
+            // A date or a date-time, only the date counts
+            NSInteger year = 0, month = 0, day = 0;
+            valid = value.length >= 8 && sscanf(value.UTF8String, "%4ld%2ld%2ld", &year, &month, &day) == 3 &&
+                    month >= 1 && month <= 12 && day >= 1 && day <= MMCalendarGregorianNumberOfDaysInMonth(year, month);
+            if (valid) {
+                pattern->untilDayNumber = MMCalendarGregorianDayNumberFromCivil(year, month, day);
+                hasUntil = YES;
+            }
+        } else if ([name isEqualToString:@"BYMONTH"]) {
+            valid = MMCalendarRecurrenceScanIntegers(value, 1, 12, ^(NSInteger integer) {
+                pattern->months |= 1u << integer;
+            });
+        } else if ([name isEqualToString:@"BYMONTHDAY"]) {
+            valid = MMCalendarRecurrenceScanIntegers(value, -31, 31, ^(NSInteger integer) {
+                if (integer > 0) pattern->monthDays |= 1u << integer;
+                else pattern->negativeMonthDays |= 1u << -integer;
+            });
+        } else if ([name isEqualToString:@"BYSETPOS"]) {
+            valid = MMCalendarRecurrenceScanIntegers(value, -366, 366, ^(NSInteger integer) {
+                if (pattern->numberOfPositions == MMCalendarRecurrenceMaximumNumberOfPositions) {
+                    valid = NO;
+                    return;
+                }
+                pattern->positions[pattern->numberOfPositions++] = integer;
+            }) && valid;
+        } else if ([name isEqualToString:@"BYDAY"]) {
+            for (NSString *item in [value componentsSeparatedByString:@","]) {
+                NSInteger weekday = item.length >= 2 ? MMCalendarRecurrenceWeekdayForName([item substringFromIndex:item.length-2]) : 0;
+                NSString *ordinalString = item.length >= 2 ? [item substringToIndex:item.length-2] : @"";
+                NSInteger ordinal = 0;
+                if (!weekday) {
+                    valid = NO;
+                } else if (!ordinalString.length) {
+                    pattern->weekdays |= 1u << weekday;
+                } else if (!MMCalendarRecurrenceScanIntegers([ordinalString stringByReplacingOccurrencesOfString:@"+" withString:@""], -53, 53, ^(NSInteger integer) {}) ||
+                           pattern->numberOfOrdinalWeekdays == MMCalendarRecurrenceMaximumNumberOfOrdinalWeekdays) {
+                    valid = NO;
+                } else {
+                    ordinal = [ordinalString stringByReplacingOccurrencesOfString:@"+" withString:@""].integerValue;
+                    pattern->ordinalWeekdays[pattern->numberOfOrdinalWeekdays++] = (MMCalendarRecurrenceOrdinalWeekday){(int8_t)ordinal, (uint8_t)weekday};
+                }
+                if (!valid) break;
+            }
+        } else if ([name isEqualToString:@"WKST"]) {
+            pattern->weekStart = MMCalendarRecurrenceWeekdayForName(value);
+            valid = pattern->weekStart != 0;
+        } else if ([@[@"BYSECOND", @"BYMINUTE", @"BYHOUR", @"BYYEARDAY", @"BYWEEKNO"] containsObject:name]) {
+            return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorUnsupportedRule, [NSString stringWithFormat:@"%@ is not supported.", name]);
+        } else {
+            valid = NO;
+        }
+        if (!valid) {
+            return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, [NSString stringWithFormat:@"\"%@\" is not a valid rule part.", part]);
+        }
+    }
+
+    if ((NSInteger)pattern->frequency < 0) {
+        return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, @"FREQ is missing.");
+    }
+    if (pattern->count && hasUntil) {
+        return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, @"COUNT and UNTIL can't be used together.");
+    }
+    if (pattern->count > MMCalendarRecurrenceMaximumCount && MMCalendarRecurrenceHasParts(pattern)) {
+        return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorUnsupportedRule, [NSString stringWithFormat:@"COUNT=%@ is more than %@ occurrences of a rule with BYxxx parts.", @(pattern->count), @(MMCalendarRecurrenceMaximumCount)]);
+    }
+    BOOL monthly = pattern->frequency == MMCalendarRecurrenceFrequencyMonthly || pattern->frequency == MMCalendarRecurrenceFrequencyYearly;
+    if (pattern->numberOfOrdinalWeekdays && !monthly) {
+        return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, @"BYDAY ordinals need FREQ=MONTHLY or YEARLY.");
+    }
+    if (MMCalendarRecurrenceHasMonthDays(pattern) && pattern->frequency == MMCalendarRecurrenceFrequencyWeekly) {
+        return MMCalendarRecurrenceError(MMCalendarRecurrenceErrorInvalidRule, @"BYMONTHDAY can't be used with FREQ=WEEKLY.");
+    }
+    MMCalendarGregorianCivilFromDayNumber(firstDayNumber, NULL, &pattern->defaultMonth, &pattern->defaultMonthDay);
+    pattern->defaultWeekday = MMCalendarRecurrenceWeekday(firstDayNumber);
+    return nil;
+}
+
+@interface MMCalendarRecurrence ()
+
+@property (assign, nonatomic) MMCalendarRecurrencePattern pattern;
+@property (assign, nonatomic) BOOL needsLastDayNumber;
+
+@end
+
+@implementation MMCalendarRecurrence
+
+@synthesize lastDayNumber = _lastDayNumber;
+
+- (instancetype)initWithRule:(NSString *)rule firstDayNumber:(MMCalendarDayNumber)firstDayNumber error:(NSError **)error
+{
+    self = [super init];
+    if (self) {
+        NSError *parseError = MMCalendarRecurrenceParse(rule, firstDayNumber, &_pattern);
+        if (parseError) {
+            if (error) *error = parseError;
+            return nil;
+        }
+        _rule = [rule copy];
+        _firstDayNumber = firstDayNumber;
+        _numberOfDays = 1;
+        _excludedDayNumbers = [[MMCalendarSelection alloc] init];
+        _lastDayNumber = _pattern.untilDayNumber;
+        _needsLastDayNumber = _pattern.count > 0;
+    }
+    return self;
+}
+
+- (MMCalendarRecurrenceFrequency)frequency
+{
+    return _pattern.frequency;
+}
+
+- (NSInteger)interval
+{
+    return _pattern.interval;
+}
+
+- (MMCalendarDayNumber)lastDayNumber
+{
+    if (self.needsLastDayNumber) {
+        if (MMCalendarRecurrenceHasParts(&_pattern)) {
+            // COUNT is the only part that needs the occurrences before, count them once
+            MMCalendarRecurrenceCountContext context = {_pattern.count, self.firstDayNumber};
+            MMCalendarRecurrenceExpand(&_pattern, self.firstDayNumber, self.firstDayNumber, MMCalendarRecurrenceMaximumDayNumber, MMCalendarRecurrenceMaximumEmptyPeriods(&_pattern), MMCalendarRecurrenceCountOccurrence, &context);
+            _lastDayNumber = context.lastDayNumber;
+        } else {
+            _lastDayNumber = MMCalendarRecurrenceDayNumberOfOccurrence(&_pattern, self.firstDayNumber, _pattern.count - 1);
+        }
+        self.needsLastDayNumber = NO;
+    }
+    return _lastDayNumber;
+}
+
+- (void)enumerateDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber usingBlock:(void (NS_NOESCAPE ^)(MMCalendarDayNumber, BOOL *))block
+{
+    lastDayNumber = MIN(lastDayNumber, self.lastDayNumber);
+    MMCalendarRecurrenceBlockContext context = {self.excludedDayNumbers, block, NO};
+    MMCalendarRecurrenceExpand(&_pattern, self.firstDayNumber, firstDayNumber, lastDayNumber, 0, MMCalendarRecurrenceCallBlock, &context);
+}
+
+@end
+
+@interface MMCalendarRecurringEventSource ()
+
+@property (strong, nonatomic) NSMutableArray<MMCalendarRecurrence *> *mutableRecurrences;
+
+// MMCalendarRecurrenceNumberOfWindows, reused least recently used first
+@property (assign, nonatomic) MMCalendarRecurrenceWindow *windows;
+@property (assign, nonatomic) NSUInteger accessCount;
+
+- (MMCalendarRecurrenceWindow *)windowForDayNumber:(MMCalendarDayNumber)dayNumber;
+- (void)expandWindow:(MMCalendarRecurrenceWindow *)window;
+- (void)invalidateWindows;
+
+@end
+
+@implementation MMCalendarRecurringEventSource
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _mutableRecurrences = [NSMutableArray array];
+        _colors = @[];
+        _windows = calloc(MMCalendarRecurrenceNumberOfWindows, sizeof(MMCalendarRecurrenceWindow));
+        for (NSInteger i = 0; i < MMCalendarRecurrenceNumberOfWindows; i++) {
+            _windows[i].index = NSIntegerMin;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSInteger i = 0; i < MMCalendarRecurrenceNumberOfWindows; i++) {
+        free(_windows[i].occurrences);
+    }
+    free(_windows);
+}
+
+- (NSArray<MMCalendarRecurrence *> *)recurrences
+{
+    return [self.mutableRecurrences copy];
+}
+
+#pragma mark - Changes
+
+- (void)addRecurrence:(MMCalendarRecurrence *)recurrence
+{
+    [self.mutableRecurrences addObject:recurrence];
+    [self invalidate];
+}
+
+- (void)removeRecurrence:(MMCalendarRecurrence *)recurrence
+{
+    [self.mutableRecurrences removeObjectIdenticalTo:recurrence];
+    [self invalidate];
+}
+
+- (void)removeAllRecurrences
+{
+    [self.mutableRecurrences removeAllObjects];
+    [self invalidate];
+}
+
+- (void)invalidate
+{
+    [self invalidateWindows];
+    [[NSNotificationCenter defaultCenter] postNotificationName:MMCalendarEventStoreDidChangeNotification object:self];
+}
+
+#pragma mark - Queries
+
+- (NSInteger)numberOfEventsForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    MMCalendarRecurrenceWindow *window = [self windowForDayNumber:dayNumber];
+    return window->numbers[MMCalendarFloorModulo(dayNumber, MMCalendarRecurrenceWindowSize)];
+}
+
+- (NSUInteger)getColorIndexes:(uint32_t *)colorIndexes maximumCount:(NSUInteger)maximumCount forDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    MMCalendarRecurrenceWindow *window = [self windowForDayNumber:dayNumber];
+    NSUInteger count = 0;
+    for (NSInteger i = 0; i < window->numberOfOccurrences && count < maximumCount; i++) {
+        MMCalendarRecurrenceOccurrence occurrence = window->occurrences[i];
+        if (occurrence.firstDayNumber > dayNumber) break;
+        if (occurrence.lastDayNumber >= dayNumber) {
+            colorIndexes[count++] = occurrence.colorIndex;
+        }
+    }
+    return count;
+}
+
+- (void)getNumberOfEvents:(NSInteger *)numbers fromDayNumber:(MMCalendarDayNumber)firstDayNumber count:(NSInteger)count
+{
+    for (NSInteger i = 0; i < count;) {
+        MMCalendarDayNumber dayNumber = firstDayNumber + i;
+        MMCalendarRecurrenceWindow *window = [self windowForDayNumber:dayNumber];
+        NSInteger offset = MMCalendarFloorModulo(dayNumber, MMCalendarRecurrenceWindowSize);
+        NSInteger length = MIN(MMCalendarRecurrenceWindowSize - offset, count - i);
+        memcpy(numbers + i, window->numbers + offset, length*sizeof(NSInteger));
+        i += length;
+    }
+}
+
+#pragma mark - Private methods
+
+- (MMCalendarRecurrenceWindow *)windowForDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    NSInteger index = MMCalendarFloorDivide(dayNumber, MMCalendarRecurrenceWindowSize);
+    MMCalendarRecurrenceWindow *window = NULL;
+    for (NSInteger i = 0; i < MMCalendarRecurrenceNumberOfWindows; i++) {
+        MMCalendarRecurrenceWindow *candidate = self.windows + i;
+        if (candidate->index == index) {
+            window = candidate;
+            break;
+        }
+        if (!window || candidate->lastAccess < window->lastAccess) {
+            window = candidate;
+        }
+    }
+    window->lastAccess = ++self.accessCount;
+    if (window->index != index) {
+        window->index = index;
+        [self expandWindow:window];
+    }
+    return window;
+}
+
+- (void)expandWindow:(MMCalendarRecurrenceWindow *)window
+{
+    MMCalendarDayNumber windowStart = window->index * MMCalendarRecurrenceWindowSize;
+    MMCalendarDayNumber windowEnd = windowStart + MMCalendarRecurrenceWindowSize - 1;
+    window->numberOfOccurrences = 0;
+    for (MMCalendarRecurrence *recurrence in self.mutableRecurrences) {
+        NSInteger numberOfDays = MAX(recurrence.numberOfDays, 1);
+        uint32_t colorIndex = recurrence.colorIndex;
+        // Occurrences starting before the window still cover its first days
+        [recurrence enumerateDayNumbersFromDayNumber:windowStart - numberOfDays + 1 toDayNumber:windowEnd usingBlock:^(MMCalendarDayNumber dayNumber, BOOL *stop) {
+            if (window->numberOfOccurrences == window->capacity) {
+                window->capacity = MAX(window->capacity*2, 16);
+                window->occurrences = realloc(window->occurrences, window->capacity*sizeof(MMCalendarRecurrenceOccurrence));
+            }
+            window->occurrences[window->numberOfOccurrences++] = (MMCalendarRecurrenceOccurrence){dayNumber, dayNumber + numberOfDays - 1, colorIndex};
+        }];
+    }
+    qsort(window->occurrences, window->numberOfOccurrences, sizeof(MMCalendarRecurrenceOccurrence), MMCalendarRecurrenceCompareOccurrences);
+
+    NSInteger differences[MMCalendarRecurrenceWindowSize+1] = {0};
+    for (NSInteger i = 0; i < window->numberOfOccurrences; i++) {
+        MMCalendarRecurrenceOccurrence occurrence = window->occurrences[i];
+        differences[MAX(occurrence.firstDayNumber - windowStart, 0)]++;
+        differences[MIN(occurrence.lastDayNumber - windowStart, MMCalendarRecurrenceWindowSize-1) + 1]--;
+    }
+    NSInteger number = 0;
+    for (NSInteger i = 0; i < MMCalendarRecurrenceWindowSize; i++) {
+        number += differences[i];
+        window->numbers[i] = number;
+    }
+}
+
+- (void)invalidateWindows
+{
+    for (NSInteger i = 0; i < MMCalendarRecurrenceNumberOfWindows; i++) {
+        self.windows[i].index = NSIntegerMin;
+        self.windows[i].numberOfOccurrences = 0;
+    }
+}
+
+@end
+
+#undef MMCalendarRecurrenceMaximumNumberOfOrdinalWeekdays
+#undef MMCalendarRecurrenceMaximumNumberOfPositions
+#undef MMCalendarRecurrenceMaximumEmptyDays
+#undef MMCalendarRecurrenceMaximumDayNumber
+#undef MMCalendarRecurrenceMaximumCount
+#undef MMCalendarRecurrenceWindowSize
+#undef MMCalendarRecurrenceNumberOfWindows
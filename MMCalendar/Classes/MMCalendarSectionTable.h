@@ -0,0 +1,111 @@
+//
+//  MMCalendarSectionTable.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Section model of the calendar: which days a month or week section shows and how many rows it takes.
+//  This file only depends on Foundation, MMCalendarCalculator adapts it to index paths and the calendar's settings.
+//
+
+#import <Foundation/Foundation.h>
+#import "MMCalendarDateEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, MMCalendarScope) {
+    MMCalendarScopeMonth,
+    MMCalendarScopeWeek
+};
+
+typedef NS_ENUM(NSUInteger, MMCalendarMonthPosition) {
+    MMCalendarMonthPositionPrevious,
+    MMCalendarMonthPositionCurrent,
+    MMCalendarMonthPositionNext,
+
+    MMCalendarMonthPositionNotFound = NSNotFound
+};
+
+typedef NS_OPTIONS(NSUInteger, MMCalendarSectionOptions) {
+    MMCalendarSectionOptionSixRows    = 1 << 0, // Every month section takes six rows
+    MMCalendarSectionOptionLeadingRow = 1 << 1  // Months starting on the first weekday are preceded by a row of the previous month
+};
+
+typedef NS_OPTIONS(uint8_t, MMCalendarDayFlags) {
+    MMCalendarDayFlagWeekend     = 1 << 0,
+    MMCalendarDayFlagToday       = 1 << 1,
+    MMCalendarDayFlagInRange     = 1 << 2,
+    MMCalendarDayFlagPlaceholder = 1 << 3
+};
+
+/**
+ * Everything a cell needs to know about its day, resolved for a whole page at once.
+ */
+struct MMCalendarDayInfo {
+    MMCalendarDayNumber dayNumber;
+    uint8_t dayOfMonth;
+    uint8_t monthPosition; // MMCalendarMonthPosition
+    MMCalendarDayFlags flags;
+};
+typedef struct MMCalendarDayInfo MMCalendarDayInfo;
+
+#define MMCalendarMaximumNumberOfDaysInPage 42
+
+/**
+ * Month metadata is kept in chunks of 32 sections, built when first asked for and evicted least recently used first.
+ * The sections never change after init and the chunks are guarded by a lock, so a table can be shared between threads.
+ */
+@interface MMCalendarSectionTable : NSObject
+
+@property (readonly, nonatomic) MMCalendarDateEngine *engine;
+@property (readonly, nonatomic) MMCalendarDayNumber minimumDayNumber;
+@property (readonly, nonatomic) MMCalendarDayNumber maximumDayNumber;
+@property (readonly, nonatomic) NSInteger numberOfMonths;
+@property (readonly, nonatomic) NSInteger numberOfWeeks;
+
+/**
+ * The maximum number of month chunks kept in memory. Default is 12.
+ */
+@property (assign, nonatomic) NSUInteger chunkBudget;
+
+- (instancetype)initWithEngine:(MMCalendarDateEngine *)engine minimumDayNumber:(MMCalendarDayNumber)minimumDayNumber maximumDayNumber:(MMCalendarDayNumber)maximumDayNumber NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (MMCalendarDayNumber)monthDayNumberForSection:(NSInteger)section;
+- (MMCalendarDayNumber)monthHeadDayNumberForSection:(NSInteger)section options:(MMCalendarSectionOptions)options;
+- (MMCalendarDayNumber)weekDayNumberForSection:(NSInteger)section;
+- (MMCalendarDayNumber)dayNumberForItem:(NSInteger)item section:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+
+/**
+ * Returns NO if the day falls before the first section.
+ */
+- (BOOL)getItem:(nullable NSInteger *)item section:(nullable NSInteger *)section forDayNumber:(MMCalendarDayNumber)dayNumber atMonthPosition:(MMCalendarMonthPosition)position scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+- (MMCalendarMonthPosition)monthPositionForItem:(NSInteger)item section:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+
+- (NSInteger)numberOfDaysInSection:(NSInteger)section;
+- (NSInteger)numberOfHeadPlaceholdersForDayNumber:(MMCalendarDayNumber)dayNumber options:(MMCalendarSectionOptions)options;
+- (NSInteger)numberOfRowsInMonthOfDayNumber:(MMCalendarDayNumber)dayNumber options:(MMCalendarSectionOptions)options;
+- (NSInteger)numberOfRowsInSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+- (NSInteger)numberOfRowsBeforeSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+
+/**
+ * The floating layout stacks each section as a header above rows of the same height. Tops are closed form, so each probe of sectionAtOffset: is constant time.
+ */
+- (double)topForSection:(NSInteger)section headerHeight:(double)headerHeight rowHeight:(double)rowHeight scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+
+/**
+ * The last of numberOfSections sections starting above the offset, or at it if inclusive, searched from firstSection.
+ */
+- (NSInteger)sectionAtOffset:(double)offset fromSection:(NSInteger)firstSection numberOfSections:(NSInteger)numberOfSections inclusive:(BOOL)inclusive headerHeight:(double)headerHeight rowHeight:(double)rowHeight scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options;
+
+/**
+ * Fills 42 day infos for a month section or 7 for a week section and returns the count. Bit n of the weekend mask stands for weekday n.
+ */
+- (NSInteger)getDayInfos:(MMCalendarDayInfo *)dayInfos forSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options today:(MMCalendarDayNumber)today weekendMask:(uint8_t)weekendMask;
+
+- (void)trimChunksToCount:(NSUInteger)count;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,429 @@
+//
+//  MMCalendarSectionTable.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarSectionTable.h"
+#import <pthread.h>
+
+#define MMCalendarMonthChunkSize 32
+
+// Metadata of up to MMCalendarMonthChunkSize consecutive month sections
+typedef struct MMCalendarMonthChunk {
+    NSInteger index;
+    NSInteger count;
+    NSUInteger lastAccess;
+    NSInteger rowOffsets[MMCalendarMonthChunkSize];
+    MMCalendarDayNumber firstDays[MMCalendarMonthChunkSize];
+    uint8_t headPlaceholders[MMCalendarMonthChunkSize];
+    uint8_t rowCounts[MMCalendarMonthChunkSize];
+    uint8_t lengths[MMCalendarMonthChunkSize];
+} MMCalendarMonthChunk;
+
+// A copy of one section of a chunk, taken under the lock
+typedef struct MMCalendarMonthEntry {
+    NSInteger rowOffset;
+    MMCalendarDayNumber firstDay;
+    NSInteger headPlaceholders;
+    NSInteger rowCount;
+    NSInteger length;
+} MMCalendarMonthEntry;
+
+@interface MMCalendarSectionTable ()
+
+@property (assign, nonatomic) NSInteger minimumMonthOrdinal;
+@property (assign, nonatomic) MMCalendarDayNumber minimumWeekDayNumber;
+
+// Resident month chunks, materialized around the sections being asked for and evicted least recently used first
+@property (assign, nonatomic) MMCalendarMonthChunk **chunks;
+@property (assign, nonatomic) NSUInteger numberOfChunks;
+@property (assign, nonatomic) NSUInteger accessCount;
+@property (assign, nonatomic) MMCalendarMonthChunk *recentChunk;
+@property (assign, nonatomic) pthread_mutex_t *lock;
+
+- (BOOL)getEntry:(MMCalendarMonthEntry *)entry forSection:(NSInteger)section materialize:(BOOL)materialize;
+- (void)unlockedTrimChunksToCount:(NSUInteger)count;
+- (NSInteger)numberOfRowsInMonthOrdinal:(NSInteger)monthOrdinal;
+- (NSInteger)numberOfRowsInMonthsBeforeSection:(NSInteger)section;
+
+- (MMCalendarMonthChunk *)chunkForSection:(NSInteger)section;
+- (MMCalendarMonthChunk *)residentChunkAtIndex:(NSInteger)index;
+- (void)fillChunk:(MMCalendarMonthChunk *)chunk atIndex:(NSInteger)index;
+
+@end
+
+@implementation MMCalendarSectionTable
+
+- (instancetype)initWithEngine:(MMCalendarDateEngine *)engine minimumDayNumber:(MMCalendarDayNumber)minimumDayNumber maximumDayNumber:(MMCalendarDayNumber)maximumDayNumber
+{
+    self = [super init];
+    if (self) {
+        _engine = engine;
+        _minimumDayNumber = minimumDayNumber;
+        _maximumDayNumber = maximumDayNumber;
+        _minimumMonthOrdinal = [engine monthOrdinalForDayNumber:minimumDayNumber];
+        _minimumWeekDayNumber = [engine firstDayOfWeekForDayNumber:minimumDayNumber];
+        _numberOfMonths = [engine monthOrdinalForDayNumber:maximumDayNumber] - _minimumMonthOrdinal + 1;
+        _numberOfWeeks = (maximumDayNumber - _minimumWeekDayNumber) / 7 + 1;
+
+        _chunkBudget = 12;
+        _chunks = malloc(sizeof(MMCalendarMonthChunk *)*_chunkBudget);
+        _numberOfChunks = 0;
+        _lock = malloc(sizeof(pthread_mutex_t));
+        pthread_mutex_init(_lock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self unlockedTrimChunksToCount:0];
+    free(_chunks);
+    pthread_mutex_destroy(_lock);
+    free(_lock);
+}
+
+- (void)setChunkBudget:(NSUInteger)chunkBudget
+{
+    chunkBudget = MAX(chunkBudget, 1);
+    pthread_mutex_lock(self.lock);
+    if (_chunkBudget != chunkBudget) {
+        [self unlockedTrimChunksToCount:chunkBudget];
+        _chunkBudget = chunkBudget;
+        self.chunks = realloc(self.chunks, sizeof(MMCalendarMonthChunk *)*chunkBudget);
+    }
+    pthread_mutex_unlock(self.lock);
+}
+
+#pragma mark - Sections
+
+- (MMCalendarDayNumber)monthDayNumberForSection:(NSInteger)section
+{
+    MMCalendarMonthEntry entry;
+    if ([self getEntry:&entry forSection:section materialize:YES]) {
+        return entry.firstDay;
+    }
+    return [self.engine firstDayOfMonthOrdinal:self.minimumMonthOrdinal+section];
+}
+
+- (MMCalendarDayNumber)monthHeadDayNumberForSection:(NSInteger)section options:(MMCalendarSectionOptions)options
+{
+    NSInteger numberOfPlaceholders;
+    MMCalendarDayNumber month;
+    MMCalendarMonthEntry entry;
+    if ([self getEntry:&entry forSection:section materialize:YES]) {
+        month = entry.firstDay;
+        // The chunk keeps the raw offset, the leading row depends on the options
+        numberOfPlaceholders = entry.headPlaceholders ?: 7 * ((options & MMCalendarSectionOptionLeadingRow) != 0);
+    } else {
+        month = [self monthDayNumberForSection:section];
+        numberOfPlaceholders = [self numberOfHeadPlaceholdersForDayNumber:month options:options];
+    }
+    return month - numberOfPlaceholders;
+}
+
+- (MMCalendarDayNumber)weekDayNumberForSection:(NSInteger)section
+{
+    return self.minimumWeekDayNumber + section * 7;
+}
+
+- (MMCalendarDayNumber)dayNumberForItem:(NSInteger)item section:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    switch (scope) {
+        case MMCalendarScopeMonth:
+            return [self monthHeadDayNumberForSection:section options:options] + item;
+        case MMCalendarScopeWeek:
+            return [self weekDayNumberForSection:section] + item;
+    }
+}
+
+- (BOOL)getItem:(NSInteger *)item section:(NSInteger *)section forDayNumber:(MMCalendarDayNumber)dayNumber atMonthPosition:(MMCalendarMonthPosition)position scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    NSInteger i = 0;
+    NSInteger s = 0;
+    switch (scope) {
+        case MMCalendarScopeMonth: {
+            s = [self.engine monthOrdinalForDayNumber:dayNumber] - self.minimumMonthOrdinal;
+            if (position == MMCalendarMonthPositionPrevious) {
+                s++;
+            } else if (position == MMCalendarMonthPositionNext) {
+                s--;
+            }
+            i = dayNumber - [self monthHeadDayNumberForSection:s options:options];
+            break;
+        }
+        case MMCalendarScopeWeek: {
+            MMCalendarDayNumber week = [self.engine firstDayOfWeekForDayNumber:dayNumber];
+            s = MMCalendarFloorDivide(week - self.minimumWeekDayNumber, 7);
+            i = dayNumber - week;
+            break;
+        }
+    }
+    if (i < 0 || s < 0) {
+        return NO;
+    }
+    if (item) *item = i;
+    if (section) *section = s;
+    return YES;
+}
+
+- (MMCalendarMonthPosition)monthPositionForItem:(NSInteger)item section:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    if (scope == MMCalendarScopeWeek) {
+        return MMCalendarMonthPositionCurrent;
+    }
+    NSInteger day = [self monthHeadDayNumberForSection:section options:options] + item - [self monthDayNumberForSection:section];
+    if (day < 0) {
+        return MMCalendarMonthPositionPrevious;
+    }
+    if (day >= [self numberOfDaysInSection:section]) {
+        return MMCalendarMonthPositionNext;
+    }
+    return MMCalendarMonthPositionCurrent;
+}
+
+#pragma mark - Rows
+
+- (NSInteger)numberOfDaysInSection:(NSInteger)section
+{
+    MMCalendarMonthEntry entry;
+    if ([self getEntry:&entry forSection:section materialize:YES]) {
+        return entry.length;
+    }
+    return [self.engine numberOfDaysInMonthOrdinal:self.minimumMonthOrdinal+section];
+}
+
+- (NSInteger)numberOfHeadPlaceholdersForDayNumber:(MMCalendarDayNumber)dayNumber options:(MMCalendarSectionOptions)options
+{
+    NSInteger currentWeekday = [self.engine weekdayForDayNumber:dayNumber];
+    NSInteger number = ((currentWeekday- self.engine.firstWeekday) + 7) % 7 ?: 7 * ((options & MMCalendarSectionOptionLeadingRow) != 0);
+    return number;
+}
+
+- (NSInteger)numberOfRowsInMonthOfDayNumber:(MMCalendarDayNumber)dayNumber options:(MMCalendarSectionOptions)options
+{
+    if (options & MMCalendarSectionOptionSixRows) return 6;
+    return [self numberOfRowsInMonthOrdinal:[self.engine monthOrdinalForDayNumber:dayNumber]];
+}
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    if (scope == MMCalendarScopeWeek) return 1;
+    if (options & MMCalendarSectionOptionSixRows) return 6;
+    MMCalendarMonthEntry entry;
+    if ([self getEntry:&entry forSection:section materialize:YES]) {
+        return entry.rowCount;
+    }
+    return [self numberOfRowsInMonthOrdinal:self.minimumMonthOrdinal+section];
+}
+
+- (NSInteger)numberOfRowsBeforeSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    if (scope == MMCalendarScopeWeek) return section;
+    if (options & MMCalendarSectionOptionSixRows) return 6 * section;
+    // Only peek at resident chunks, a binary search over the whole range should not pull in every chunk it visits
+    MMCalendarMonthEntry entry;
+    if ([self getEntry:&entry forSection:section materialize:NO]) {
+        return entry.rowOffset;
+    }
+    return [self numberOfRowsInMonthsBeforeSection:section];
+}
+
+- (double)topForSection:(NSInteger)section headerHeight:(double)headerHeight rowHeight:(double)rowHeight scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    return section * headerHeight + [self numberOfRowsBeforeSection:section scope:scope options:options] * rowHeight;
+}
+
+- (NSInteger)sectionAtOffset:(double)offset fromSection:(NSInteger)firstSection numberOfSections:(NSInteger)numberOfSections inclusive:(BOOL)inclusive headerHeight:(double)headerHeight rowHeight:(double)rowHeight scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options
+{
+    NSInteger low = MAX(firstSection, 0), high = MAX(numberOfSections-1, low);
+    while (low < high) {
+        NSInteger middle = low + (high-low+1)/2;
+        double top = [self topForSection:middle headerHeight:headerHeight rowHeight:rowHeight scope:scope options:options];
+        if (top < offset || (inclusive && top == offset)) {
+            low = middle;
+        } else {
+            high = middle-1;
+        }
+    }
+    return low;
+}
+
+#pragma mark - Days
+
+- (NSInteger)getDayInfos:(MMCalendarDayInfo *)dayInfos forSection:(NSInteger)section scope:(MMCalendarScope)scope options:(MMCalendarSectionOptions)options today:(MMCalendarDayNumber)today weekendMask:(uint8_t)weekendMask
+{
+    NSInteger count = 0;
+    MMCalendarDayNumber firstDay = 0, monthStart = 0, monthEnd = 0;
+    switch (scope) {
+        case MMCalendarScopeMonth: {
+            count = MMCalendarMaximumNumberOfDaysInPage;
+            firstDay = [self monthHeadDayNumberForSection:section options:options];
+            monthStart = [self monthDayNumberForSection:section];
+            monthEnd = monthStart + [self numberOfDaysInSection:section];
+            break;
+        }
+        case MMCalendarScopeWeek: {
+            count = 7;
+            firstDay = [self weekDayNumberForSection:section];
+            break;
+        }
+    }
+
+    // Only the first day goes through the engine, the others are counted forward
+    NSInteger monthOrdinal = [self.engine monthOrdinalForDayNumber:firstDay];
+    MMCalendarDayNumber nextMonth = [self.engine firstDayOfMonthOrdinal:monthOrdinal+1];
+    NSInteger dayOfMonth = [self.engine dayOfMonthForDayNumber:firstDay];
+    NSInteger weekday = [self.engine weekdayForDayNumber:firstDay];
+    for (NSInteger i = 0; i < count; i++) {
+        MMCalendarDayNumber dayNumber = firstDay + i;
+        if (dayNumber == nextMonth) {
+            dayOfMonth = 1;
+            monthOrdinal++;
+            nextMonth = [self.engine firstDayOfMonthOrdinal:monthOrdinal+1];
+        }
+        MMCalendarMonthPosition monthPosition = MMCalendarMonthPositionCurrent;
+        if (scope == MMCalendarScopeMonth) {
+            if (dayNumber < monthStart) {
+                monthPosition = MMCalendarMonthPositionPrevious;
+            } else if (dayNumber >= monthEnd) {
+                monthPosition = MMCalendarMonthPositionNext;
+            }
+        }
+        BOOL inRange = dayNumber >= self.minimumDayNumber && dayNumber <= self.maximumDayNumber;
+        MMCalendarDayFlags flags = 0;
+        if (weekendMask & (1 << weekday)) flags |= MMCalendarDayFlagWeekend;
+        if (dayNumber == today) flags |= MMCalendarDayFlagToday;
+        if (inRange) flags |= MMCalendarDayFlagInRange;
+        if (monthPosition != MMCalendarMonthPositionCurrent || !inRange) flags |= MMCalendarDayFlagPlaceholder;
+        dayInfos[i] = (MMCalendarDayInfo){dayNumber, dayOfMonth, monthPosition, flags};
+        dayOfMonth++;
+        weekday = weekday % 7 + 1;
+    }
+    return count;
+}
+
+#pragma mark - Chunks
+
+- (void)trimChunksToCount:(NSUInteger)count
+{
+    pthread_mutex_lock(self.lock);
+    [self unlockedTrimChunksToCount:count];
+    pthread_mutex_unlock(self.lock);
+}
+
+#pragma mark - Private methods
+
+- (BOOL)getEntry:(MMCalendarMonthEntry *)entry forSection:(NSInteger)section materialize:(BOOL)materialize
+{
+    if (section < 0 || section >= self.numberOfMonths) return NO;
+    pthread_mutex_lock(self.lock);
+    MMCalendarMonthChunk *chunk = materialize ? [self chunkForSection:section] : [self residentChunkAtIndex:section/MMCalendarMonthChunkSize];
+    if (chunk) {
+        NSInteger index = section-chunk->index*MMCalendarMonthChunkSize;
+        *entry = (MMCalendarMonthEntry){chunk->rowOffsets[index], chunk->firstDays[index], chunk->headPlaceholders[index], chunk->rowCounts[index], chunk->lengths[index]};
+    }
+    pthread_mutex_unlock(self.lock);
+    return chunk != NULL;
+}
+
+- (void)unlockedTrimChunksToCount:(NSUInteger)count
+{
+    while (self.numberOfChunks > count) {
+        NSUInteger coldest = 0;
+        for (NSUInteger i = 1; i < self.numberOfChunks; i++) {
+            if (self.chunks[i]->lastAccess < self.chunks[coldest]->lastAccess) {
+                coldest = i;
+            }
+        }
+        if (self.chunks[coldest] == self.recentChunk) {
+            self.recentChunk = NULL;
+        }
+        free(self.chunks[coldest]);
+        self.numberOfChunks--;
+        self.chunks[coldest] = self.chunks[self.numberOfChunks];
+    }
+}
+
+- (NSInteger)numberOfRowsInMonthOrdinal:(NSInteger)monthOrdinal
+{
+    MMCalendarDayNumber firstDayOfMonth = [self.engine firstDayOfMonthOrdinal:monthOrdinal];
+    NSInteger numberOfDaysInMonth = [self.engine numberOfDaysInMonthOrdinal:monthOrdinal];
+    NSInteger numberOfPlaceholdersForPrev = (([self.engine weekdayForDayNumber:firstDayOfMonth] - self.engine.firstWeekday) + 7) % 7;
+    NSInteger headDayCount = numberOfDaysInMonth + numberOfPlaceholdersForPrev;
+    NSInteger numberOfRows = (headDayCount/7) + (headDayCount%7>0);
+    return numberOfRows;
+}
+
+- (NSInteger)numberOfRowsInMonthsBeforeSection:(NSInteger)section
+{
+    if (section <= 0) return 0;
+    // Every month takes one row per week it touches, and two adjacent months share a row unless the later one starts a week
+    NSInteger monthOrdinal = self.minimumMonthOrdinal + section;
+    MMCalendarDayNumber firstDay = [self.engine firstDayOfMonthOrdinal:self.minimumMonthOrdinal];
+    MMCalendarDayNumber lastDay = [self.engine firstDayOfMonthOrdinal:monthOrdinal] - 1;
+    NSInteger numberOfWeeks = ([self.engine firstDayOfWeekForDayNumber:lastDay] - [self.engine firstDayOfWeekForDayNumber:firstDay]) / 7;
+    NSInteger numberOfWeekStarts = [self.engine numberOfMonthsStartingWeeksFromMonthOrdinal:self.minimumMonthOrdinal+1 toMonthOrdinal:monthOrdinal];
+    return numberOfWeeks + section - numberOfWeekStarts;
+}
+
+- (MMCalendarMonthChunk *)chunkForSection:(NSInteger)section
+{
+    NSInteger index = section / MMCalendarMonthChunkSize;
+    MMCalendarMonthChunk *chunk = [self residentChunkAtIndex:index];
+    if (!chunk) {
+        if (self.numberOfChunks >= _chunkBudget) {
+            [self unlockedTrimChunksToCount:_chunkBudget-1];
+        }
+        chunk = malloc(sizeof(MMCalendarMonthChunk));
+        [self fillChunk:chunk atIndex:index];
+        self.chunks[self.numberOfChunks] = chunk;
+        self.numberOfChunks++;
+    }
+    chunk->lastAccess = ++_accessCount;
+    self.recentChunk = chunk;
+    return chunk;
+}
+
+- (MMCalendarMonthChunk *)residentChunkAtIndex:(NSInteger)index
+{
+    if (self.recentChunk && self.recentChunk->index == index) {
+        return self.recentChunk;
+    }
+    for (NSUInteger i = 0; i < self.numberOfChunks; i++) {
+        if (self.chunks[i]->index == index) {
+            return self.chunks[i];
+        }
+    }
+    return NULL;
+}
+
+- (void)fillChunk:(MMCalendarMonthChunk *)chunk atIndex:(NSInteger)index
+{
+    NSInteger startSection = index * MMCalendarMonthChunkSize;
+    chunk->index = index;
+    chunk->count = MIN(MMCalendarMonthChunkSize, self.numberOfMonths-startSection);
+    // Month boundaries are contiguous, so each month starts where the previous one ended
+    MMCalendarDayNumber firstDay = [self.engine firstDayOfMonthOrdinal:self.minimumMonthOrdinal+startSection];
+    NSInteger rowOffset = [self numberOfRowsInMonthsBeforeSection:startSection];
+    for (NSInteger i = 0; i < chunk->count; i++) {
+        NSInteger numberOfDays = [self.engine numberOfDaysInMonthOrdinal:self.minimumMonthOrdinal+startSection+i];
+        NSInteger numberOfPlaceholders = (([self.engine weekdayForDayNumber:firstDay] - self.engine.firstWeekday) + 7) % 7;
+        NSInteger headDayCount = numberOfDays + numberOfPlaceholders;
+        NSInteger numberOfRows = (headDayCount/7) + (headDayCount%7>0);
+        chunk->rowOffsets[i] = rowOffset;
+        chunk->firstDays[i] = firstDay;
+        chunk->headPlaceholders[i] = numberOfPlaceholders;
+        chunk->rowCounts[i] = numberOfRows;
+        chunk->lengths[i] = numberOfDays;
+        rowOffset += numberOfRows;
+        firstDay += numberOfDays;
+    }
+}
+
+@end
+
+#undef MMCalendarMonthChunkSize
@@ -0,0 +1,55 @@
+//
+//  MMCalendarSelection.h
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+//  Selected days kept as a bitset of day numbers.
+//  This file only depends on Foundation.
+//
+
+#import <Foundation/Foundation.h>
+#import "MMCalendarDateEngine.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * One bit per day between the earliest and the latest selected day, so membership is a single word lookup.
+ */
+@interface MMCalendarSelection : NSObject
+
+@property (readonly, nonatomic) NSUInteger count;
+
+/**
+ * The most recently added day that is still selected. Only the last 16 days added are remembered in order, past them this is the latest selected day. NSIntegerMin if empty.
+ */
+@property (readonly, nonatomic) MMCalendarDayNumber lastDayNumber;
+
+- (BOOL)containsDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Returns NO if the day was already selected.
+ */
+- (BOOL)addDayNumber:(MMCalendarDayNumber)dayNumber;
+
+/**
+ * Returns NO if the day was not selected.
+ */
+- (BOOL)removeDayNumber:(MMCalendarDayNumber)dayNumber;
+- (void)removeAllDayNumbers;
+
+/**
+ * Fills or clears a closed range a word at a time and returns the number of days that changed.
+ */
+- (NSUInteger)addDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber;
+- (NSUInteger)removeDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber;
+
+/**
+ * Enumerates the selected days in ascending order.
+ */
+- (void)enumerateDayNumbersUsingBlock:(void (NS_NOESCAPE ^)(MMCalendarDayNumber dayNumber, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
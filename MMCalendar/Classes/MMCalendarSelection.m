@@ -0,0 +1,222 @@
+//
+//  MMCalendarSelection.m
+//  MMCalendar
+//
+//  Created by Mir on 10/17/26.
+//  Copyright © 2026 Mir. All rights reserved.
+//
+
+#import "MMCalendarSelection.h"
+
+#define MMCalendarSelectionWordBits 64
+
+// Enough recent days to step back through a few deselections, like a list in selection order would
+#define MMCalendarSelectionNumberOfRecentDays 16
+
+// Bits firstBit through lastBit of a word
+#define MMCalendarSelectionMask(firstBit, lastBit) ((~0ull >> (MMCalendarSelectionWordBits-1-(lastBit))) & (~0ull << (firstBit)))
+
+@interface MMCalendarSelection ()
+{
+    // Days in the order they were added, the most recent last. Removed days are taken out
+    MMCalendarDayNumber _recentDayNumbers[MMCalendarSelectionNumberOfRecentDays];
+    NSInteger _numberOfRecentDayNumbers;
+}
+
+@property (assign, nonatomic) NSUInteger count;
+
+// Bit i of word w stands for day (firstWord+w)*64+i
+@property (assign, nonatomic) uint64_t *words;
+@property (assign, nonatomic) NSInteger firstWord;
+@property (assign, nonatomic) NSInteger numberOfWords;
+
+- (uint64_t *)wordForDayNumber:(MMCalendarDayNumber)dayNumber growing:(BOOL)growing;
+- (MMCalendarDayNumber)maximumDayNumber;
+- (void)pushRecentDayNumber:(MMCalendarDayNumber)dayNumber;
+- (void)removeRecentDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber;
+
+@end
+
+@implementation MMCalendarSelection
+
+- (void)dealloc
+{
+    free(_words);
+}
+
+- (MMCalendarDayNumber)lastDayNumber
+{
+    if (_numberOfRecentDayNumbers) {
+        return _recentDayNumbers[_numberOfRecentDayNumbers-1];
+    }
+    return self.count ? [self maximumDayNumber] : NSIntegerMin;
+}
+
+- (BOOL)containsDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    uint64_t *word = [self wordForDayNumber:dayNumber growing:NO];
+    return word && (*word >> MMCalendarFloorModulo(dayNumber, MMCalendarSelectionWordBits) & 1);
+}
+
+- (BOOL)addDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    uint64_t *word = [self wordForDayNumber:dayNumber growing:YES];
+    uint64_t bit = 1ull << MMCalendarFloorModulo(dayNumber, MMCalendarSelectionWordBits);
+    if (*word & bit) {
+        return NO;
+    }
+    *word |= bit;
+    self.count++;
+    [self pushRecentDayNumber:dayNumber];
+    return YES;
+}
+
+- (BOOL)removeDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    uint64_t *word = [self wordForDayNumber:dayNumber growing:NO];
+    uint64_t bit = 1ull << MMCalendarFloorModulo(dayNumber, MMCalendarSelectionWordBits);
+    if (!word || !(*word & bit)) {
+        return NO;
+    }
+    *word &= ~bit;
+    self.count--;
+    [self removeRecentDayNumbersFromDayNumber:dayNumber toDayNumber:dayNumber];
+    return YES;
+}
+
+- (void)removeAllDayNumbers
+{
+    free(self.words);
+    self.words = NULL;
+    self.numberOfWords = 0;
+    self.count = 0;
+    _numberOfRecentDayNumbers = 0;
+}
+
+- (NSUInteger)addDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber
+{
+    if (firstDayNumber > lastDayNumber) return 0;
+    // Grow once for both ends, the words in between are looked up without growing
+    [self wordForDayNumber:firstDayNumber growing:YES];
+    [self wordForDayNumber:lastDayNumber growing:YES];
+    NSUInteger numberOfAddedDays = 0;
+    for (MMCalendarDayNumber dayNumber = firstDayNumber; dayNumber <= lastDayNumber;) {
+        NSInteger firstBit = MMCalendarFloorModulo(dayNumber, MMCalendarSelectionWordBits);
+        NSInteger lastBit = MIN(MMCalendarSelectionWordBits-1, firstBit+lastDayNumber-dayNumber);
+        uint64_t mask = MMCalendarSelectionMask(firstBit, lastBit);
+        uint64_t *word = [self wordForDayNumber:dayNumber growing:NO];
+        numberOfAddedDays += __builtin_popcountll(mask & ~*word);
+        *word |= mask;
+        dayNumber += lastBit - firstBit + 1;
+    }
+    if (numberOfAddedDays) {
+        self.count += numberOfAddedDays;
+        // As if added one by one, only the last few matter
+        for (MMCalendarDayNumber dayNumber = MAX(firstDayNumber, lastDayNumber-MMCalendarSelectionNumberOfRecentDays+1); dayNumber <= lastDayNumber; dayNumber++) {
+            [self pushRecentDayNumber:dayNumber];
+        }
+    }
+    return numberOfAddedDays;
+}
+
+- (NSUInteger)removeDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber
+{
+    if (!self.numberOfWords) return 0;
+    // Only the part of the range inside the storage can hold selected days
+    firstDayNumber = MAX(firstDayNumber, self.firstWord*MMCalendarSelectionWordBits);
+    lastDayNumber = MIN(lastDayNumber, (self.firstWord+self.numberOfWords)*MMCalendarSelectionWordBits-1);
+    NSUInteger numberOfRemovedDays = 0;
+    for (MMCalendarDayNumber dayNumber = firstDayNumber; dayNumber <= lastDayNumber;) {
+        NSInteger firstBit = MMCalendarFloorModulo(dayNumber, MMCalendarSelectionWordBits);
+        NSInteger lastBit = MIN(MMCalendarSelectionWordBits-1, firstBit+lastDayNumber-dayNumber);
+        uint64_t mask = MMCalendarSelectionMask(firstBit, lastBit);
+        uint64_t *word = [self wordForDayNumber:dayNumber growing:NO];
+        numberOfRemovedDays += __builtin_popcountll(mask & *word);
+        *word &= ~mask;
+        dayNumber += lastBit - firstBit + 1;
+    }
+    if (numberOfRemovedDays) {
+        self.count -= numberOfRemovedDays;
+        [self removeRecentDayNumbersFromDayNumber:firstDayNumber toDayNumber:lastDayNumber];
+    }
+    return numberOfRemovedDays;
+}
+
+- (void)enumerateDayNumbersUsingBlock:(void (NS_NOESCAPE ^)(MMCalendarDayNumber, BOOL *))block
+{
+    BOOL stop = NO;
+    for (NSInteger w = 0; w < self.numberOfWords; w++) {
+        uint64_t word = self.words[w];
+        while (word) {
+            NSInteger bit = __builtin_ctzll(word);
+            block((self.firstWord+w)*MMCalendarSelectionWordBits+bit, &stop);
+            if (stop) return;
+            word &= word - 1;
+        }
+    }
+}
+
+#pragma mark - Private methods
+
+- (uint64_t *)wordForDayNumber:(MMCalendarDayNumber)dayNumber growing:(BOOL)growing
+{
+    NSInteger index = MMCalendarFloorDivide(dayNumber, MMCalendarSelectionWordBits);
+    if (self.numberOfWords && index >= self.firstWord && index < self.firstWord+self.numberOfWords) {
+        return self.words + index - self.firstWord;
+    }
+    if (!growing) {
+        return NULL;
+    }
+    // Grow by half of the current span on the side that overflowed, so that selecting day by day stays amortized constant
+    NSInteger padding = self.numberOfWords/2;
+    NSInteger firstWord = self.numberOfWords ? MIN(self.firstWord, index-padding) : index;
+    NSInteger lastWord = self.numberOfWords ? MAX(self.firstWord+self.numberOfWords-1, index+padding) : index;
+    NSInteger numberOfWords = lastWord - firstWord + 1;
+    uint64_t *words = calloc(numberOfWords, sizeof(uint64_t));
+    if (self.numberOfWords) {
+        memcpy(words + self.firstWord - firstWord, self.words, self.numberOfWords*sizeof(uint64_t));
+    }
+    free(self.words);
+    self.words = words;
+    self.firstWord = firstWord;
+    self.numberOfWords = numberOfWords;
+    return self.words + index - self.firstWord;
+}
+
+- (void)pushRecentDayNumber:(MMCalendarDayNumber)dayNumber
+{
+    // A day added again moves to the end
+    [self removeRecentDayNumbersFromDayNumber:dayNumber toDayNumber:dayNumber];
+    if (_numberOfRecentDayNumbers == MMCalendarSelectionNumberOfRecentDays) {
+        memmove(_recentDayNumbers, _recentDayNumbers+1, (MMCalendarSelectionNumberOfRecentDays-1)*sizeof(MMCalendarDayNumber));
+        _numberOfRecentDayNumbers--;
+    }
+    _recentDayNumbers[_numberOfRecentDayNumbers++] = dayNumber;
+}
+
+- (void)removeRecentDayNumbersFromDayNumber:(MMCalendarDayNumber)firstDayNumber toDayNumber:(MMCalendarDayNumber)lastDayNumber
+{
+    NSInteger count = 0;
+    for (NSInteger i = 0; i < _numberOfRecentDayNumbers; i++) {
+        if (_recentDayNumbers[i] < firstDayNumber || _recentDayNumbers[i] > lastDayNumber) {
+            _recentDayNumbers[count++] = _recentDayNumbers[i];
+        }
+    }
+    _numberOfRecentDayNumbers = count;
+}
+
+- (MMCalendarDayNumber)maximumDayNumber
+{
+    for (NSInteger w = self.numberOfWords-1; w >= 0; w--) {
+        if (self.words[w]) {
+            return (self.firstWord+w)*MMCalendarSelectionWordBits + MMCalendarSelectionWordBits-1 - __builtin_clzll(self.words[w]);
+        }
+    }
+    return NSIntegerMin;
+}
+
+@end
+
+#undef MMCalendarSelectionWordBits
+#undef MMCalendarSelectionNumberOfRecentDays
+#undef MMCalendarSelectionMask
@@ -17,6 +17,12 @@
 @property (strong  , nonatomic) MMCalendarTransitionAttributes *pendingAttributes;
 @property (assign  , nonatomic) CGFloat lastTranslation;
 
+// The grid and its focused row rendered once, moved in place of the collection view during a scope gesture
+@property (strong  , nonatomic) UIView *snapshotView;
+@property (weak    , nonatomic) UIView *fadingSnapshotView;
+// Holds the snapshots outside of the days container, as tall as the taller scope and clipped to the height the gesture has reached
+@property (weak    , nonatomic) UIView *snapshotClipView;
+
 - (void)performTransitionCompletionAnimated:(BOOL)animated;
 - (void)performTransitionCompletion:(MMCalendarTransition)transition animated:(BOOL)animated;
 
@@ -26,6 +32,9 @@
 - (void)performAlphaAnimationWithProgress:(CGFloat)progress;
 - (void)performPathAnimationWithProgress:(CGFloat)progress;
 
+- (void)installTransitionSnapshots;
+- (void)removeTransitionSnapshotsWithProgress:(CGFloat)progress;
+
 - (void)scopeTransitionDidBegin:(UIPanGestureRecognizer *)panGesture;
 - (void)scopeTransitionDidUpdate:(UIPanGestureRecognizer *)panGesture;
 - (void)scopeTransitionDidEnd:(UIPanGestureRecognizer *)panGesture;
@@ -148,6 +157,7 @@
         self.collectionView.fs_top = -self.pendingAttributes.focusedRowNumber*self.calendar.collectionViewLayout.estimatedItemSize.height;
         
     }
+    [self installTransitionSnapshots];
 }
 
 - (void)scopeTransitionDidUpdate:(UIPanGestureRecognizer *)panGesture
@@ -208,6 +218,7 @@
                 CGFloat progress = translation/minTranslation;
                 progress;
             });
+            [self removeTransitionSnapshotsWithProgress:progress];
             if (velocity >= 0) {
                 [self performBackwardTransition:self.transition fromProgress:progress];
             } else {
@@ -223,6 +234,7 @@
                 CGFloat progress = translation/maxTranslation;
                 progress;
             });
+            [self removeTransitionSnapshotsWithProgress:progress];
             if (velocity >= 0) {
                 [self performForwardTransition:self.transition fromProgress:progress];
             } else {
@@ -750,6 +762,11 @@
 - (void)performAlphaAnimationWithProgress:(CGFloat)progress
 {
     CGFloat opacity = self.transition == MMCalendarTransitionMonthToWeek ? MAX((1-progress*1.1),0) : progress;
+    if (self.snapshotView) {
+        // The focused row is a snapshot of its own above the fading one
+        self.fadingSnapshotView.alpha = opacity;
+        return;
+    }
     [self.calendar.visibleCells enumerateObjectsUsingBlock:^(MMCalendarCell *cell, NSUInteger idx, BOOL *stop) {
         if (CGRectContainsPoint(self.collectionView.bounds, cell.center)) {
             BOOL shouldPerformAlpha = NO;
@@ -769,14 +786,77 @@
     CGFloat sourceHeight = CGRectGetHeight(self.pendingAttributes.sourceBounds);
     CGFloat currentHeight = sourceHeight - (sourceHeight-targetHeight)*progress - self.calendar.scopeHandle.fs_height;
     CGRect currentBounds = CGRectMake(0, 0, CGRectGetWidth(self.pendingAttributes.targetBounds), currentHeight+self.calendar.scopeHandle.fs_height);
-    self.collectionView.fs_top = (-self.pendingAttributes.focusedRowNumber*self.calendar.collectionViewLayout.estimatedItemSize.height)*(self.transition == MMCalendarTransitionMonthToWeek?progress:(1-progress));
-    [self boundingRectWillChange:currentBounds animated:NO];
+    UIView *gridView = self.snapshotView ?: self.collectionView;
+    gridView.fs_top = (-self.pendingAttributes.focusedRowNumber*self.calendar.collectionViewLayout.estimatedItemSize.height)*(self.transition == MMCalendarTransitionMonthToWeek?progress:(1-progress));
+    if (!self.snapshotView) {
+        [self boundingRectWillChange:currentBounds animated:NO];
+    } else {
+        // The calendar keeps the bounds the gesture began with, the delegate hears once when the snapshots are removed
+        self.snapshotClipView.fs_height = CGRectGetHeight(currentBounds) - self.calendar.scopeHandle.fs_height - self.snapshotClipView.fs_top;
+        CGAffineTransform transform = CGAffineTransformMakeTranslation(0, CGRectGetHeight(currentBounds) - self.calendar.fs_height);
+        self.calendar.scopeHandle.transform = transform;
+        self.calendar.bottomBorder.transform = transform;
+    }
     if (self.transition == MMCalendarTransitionWeekToMonth) {
         self.calendar.contentView.fs_height = targetHeight;
     }
 }
 
 
+- (void)installTransitionSnapshots
+{
+    if (!self.calendar.usesSnapshotsForScopeGesture || self.snapshotView) return;
+    
+    // Both grids of the transition are in the month layout, the week is its focused row
+    UIView *fadingView = [self.collectionView snapshotViewAfterScreenUpdates:YES];
+    if (!fadingView) return;
+    CGFloat rowHeight = self.collectionViewLayout.estimatedItemSize.height;
+    CGRect focusedRect = CGRectMake(0, self.collectionViewLayout.sectionInsets.top+self.pendingAttributes.focusedRowNumber*rowHeight, self.collectionView.fs_width, rowHeight);
+    CGPoint contentOffset = self.collectionView.contentOffset;
+    UIView *focusedView = [self.collectionView resizableSnapshotViewFromRect:CGRectOffset(focusedRect, contentOffset.x, contentOffset.y) afterScreenUpdates:NO withCapInsets:UIEdgeInsetsZero];
+    
+    UIView *snapshotView = [[UIView alloc] initWithFrame:self.collectionView.frame];
+    snapshotView.userInteractionEnabled = NO;
+    fadingView.frame = snapshotView.bounds;
+    [snapshotView addSubview:fadingView];
+    if (focusedView) {
+        focusedView.frame = focusedRect;
+        [snapshotView addSubview:focusedView];
+    }
+    
+    // The days container and the content view are clipped to the bounds the gesture began with, the grid grows or shrinks past them
+    CGFloat top = [self.collectionView.superview convertPoint:CGPointZero toView:self.calendar].y;
+    CGFloat height = MAX(CGRectGetHeight(self.pendingAttributes.sourceBounds), CGRectGetHeight(self.pendingAttributes.targetBounds)) - self.calendar.scopeHandle.fs_height - top;
+    UIView *clipView = [[UIView alloc] initWithFrame:CGRectMake(0, top, self.calendar.fs_width, height)];
+    clipView.userInteractionEnabled = NO;
+    clipView.clipsToBounds = YES;
+    [clipView addSubview:snapshotView];
+    [self.calendar insertSubview:clipView aboveSubview:self.calendar.contentView];
+    self.collectionView.hidden = YES;
+    self.snapshotView = snapshotView;
+    self.fadingSnapshotView = fadingView;
+    self.snapshotClipView = clipView;
+    [self performPathAnimationWithProgress:0];
+}
+
+- (void)removeTransitionSnapshotsWithProgress:(CGFloat)progress
+{
+    UIView *snapshotView = self.snapshotView;
+    if (!snapshotView) return;
+    self.snapshotView = nil;
+    
+    // Cells take over where the snapshots are, the finishing animations start from there
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.calendar.scopeHandle.transform = CGAffineTransformIdentity;
+    self.calendar.bottomBorder.transform = CGAffineTransformIdentity;
+    [self performAlphaAnimationWithProgress:progress];
+    [self performPathAnimationWithProgress:progress];
+    self.collectionView.hidden = NO;
+    [CATransaction commit];
+    [self.snapshotClipView removeFromSuperview];
+}
+
 - (void)prelayoutForWeekToMonthTransition
 {
     self.calendar.contentView.clipsToBounds = YES;